@@ -0,0 +1,608 @@
+/***********************************************************
+* Filename:					Benchmark.cpp
+*
+* OVERVIEW:
+*	Times the board engine on fixed-seed boards so that a
+*	change to the containers or to Board.cpp can be compared
+*	with the version before it.
+*
+*	Every scenario is run on the Beginner, Intermediate and
+*	Expert presets and on synthetic 1000x1000 and 4000x4000
+*	boards at Expert density. The cascade scenarios also run
+*	on a "worst case" board of each size that holds a single
+*	bomb, so that one click opens almost the whole board (on
+*	every core, and as "(serial)" on one thread), and
+*	on a chunked board of the same size and density, where the
+*	tiles are made as the cascade reaches them. The snapshot
+*	scenarios write a scratch file in the working directory.
+*	The "(fixed)" scenarios run the same work on the FixedBoard
+*	of each preset, and the "(labels)" ones on a Board whose
+*	blank regions were found beforehand by LabelRegions().
+*	The "Viewport" scenarios draw an 80x24 window of each
+*	board, so their time should not grow with the board.
+*
+* INPUT:
+*	Benchmark [filter]
+*		Only runs the scenarios whose name or board contains
+*		the filter text.
+*
+* OUPUT:
+*	One line per scenario in the format:
+*
+*		scenario            board          ns/op      cells/s  allocs/op
+************************************************************/
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "Array.h"
+#include "Array2D.h"
+#include "Board.h"
+#include "ChunkedArray2D.h"
+#include "FixedBoard.h"
+#include "MineProbability.h"
+#include "Renderer.h"
+#include "Solver.h"
+#include "Viewport.h"
+
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+// Keep running a scenario until it has been timed for this long
+const double MIN_SECONDS = 0.25;
+const long long MAX_ITERATIONS = 1000000;
+
+// Scratch file for the snapshot scenarios
+const char * const SNAPSHOT_FILE = "Benchmark.snapshot";
+const unsigned long long SEED = 20140113ULL;
+
+// Screen the Viewport scenarios draw on
+const int VIEW_LINES = 24;
+const int VIEW_COLUMNS = 80;
+
+static std::atomic<long long> g_allocations( 0 );
+
+void * operator new( size_t size )
+{
+	g_allocations++;
+
+	void * memory = malloc( size == 0 ? 1 : size );
+
+	if( memory == nullptr )
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void * operator new[]( size_t size )
+{
+	return operator new( size );
+}
+
+void operator delete( void * memory ) noexcept
+{
+	free( memory );
+}
+
+void operator delete[]( void * memory ) noexcept
+{
+	free( memory );
+}
+
+void operator delete( void * memory, size_t ) noexcept
+{
+	free( memory );
+}
+
+void operator delete[]( void * memory, size_t ) noexcept
+{
+	free( memory );
+}
+
+struct BoardSize
+{
+	const char * name;
+	int rows;
+	int cols;
+	int bombs;
+};
+
+// Keeps results alive so the compiler cannot throw the work away
+static volatile long long g_sink = 0;
+static const char * g_filter = nullptr;
+
+/***************************************************************
+*   Purpose: Decides whether a scenario was asked for.
+*
+*     Entry: The scenario and board names.
+*
+*      Exit: Returns true if there is no filter or either name
+*			 contains it.
+****************************************************************/
+bool Selected( const char * scenario, const char * board )
+{
+	return g_filter == nullptr || strstr( scenario, g_filter ) != nullptr ||
+		   strstr( board, g_filter ) != nullptr;
+}
+
+/***************************************************************
+*   Purpose: Prints one result line.
+*
+*     Entry: The names, the total time, the number of operations,
+*			 cells touched per operation and allocations made.
+*
+*      Exit: None
+****************************************************************/
+void Report( const char * scenario, const char * board, double seconds,
+			 long long ops, double cells_per_op, long long allocations )
+{
+	const double ns_per_op = seconds * 1e9 / ops;
+	const double cells_per_second = cells_per_op * ops / seconds;
+
+	printf( "%-22s %-14s %14.1f %14.4g %10.2f\n", scenario, board, ns_per_op,
+			cells_per_second, static_cast<double>( allocations ) / ops );
+}
+
+/***************************************************************
+*   Purpose: Times a scenario that needs no fresh state between
+*			 runs.
+*
+*     Entry: The names, the cells touched per run and the work.
+*
+*      Exit: The result line is printed.
+****************************************************************/
+template<class Work>
+void Measure( const char * scenario, const char * board, double cells_per_op,
+			  Work work )
+{
+	if( Selected( scenario, board ) == false )
+		return;
+
+	long long ops = 0;
+	long long batch = 1;
+	long long allocations = g_allocations;
+	double seconds = 0;
+
+	work(); // Warm up
+	allocations = g_allocations;
+
+	while( seconds < MIN_SECONDS && ops < MAX_ITERATIONS )
+	{
+		Clock::time_point start = Clock::now();
+
+		for( long long i = 0; i < batch; ++i )
+			work();
+
+		seconds += std::chrono::duration<double>( Clock::now() - start ).count();
+		ops += batch;
+		batch *= 2;
+	}
+
+	Report( scenario, board, seconds, ops, cells_per_op, g_allocations - allocations );
+}
+
+/***************************************************************
+*   Purpose: Times a scenario that changes the Board, restoring
+*			 a copy of it before every run. Only the work itself
+*			 is timed and counted.
+*
+*     Entry: The names, the cells touched per run, the Board to
+*			 start from and the work.
+*
+*      Exit: The result line is printed.
+****************************************************************/
+template<class Work>
+void MeasureFresh( const char * scenario, const char * board, double cells_per_op,
+				   const Board & original, Work work )
+{
+	if( Selected( scenario, board ) == false )
+		return;
+
+	long long ops = 0;
+	long long allocations = 0;
+	double seconds = 0;
+	Board copy( original );
+
+	while( seconds < MIN_SECONDS && ops < MAX_ITERATIONS )
+	{
+		copy = original;
+
+		long long before = g_allocations;
+		Clock::time_point start = Clock::now();
+
+		work( copy );
+
+		seconds += std::chrono::duration<double>( Clock::now() - start ).count();
+		allocations += g_allocations - before;
+		ops++;
+	}
+
+	Report( scenario, board, seconds, ops, cells_per_op, allocations );
+}
+
+/***************************************************************
+*   Purpose: Finds a blank, non bomb Cell to click on, searching
+*			 from the centre of the Board outwards row by row.
+*
+*     Entry: The Board and where to store the row and column.
+*
+*      Exit: Returns false if the Board has no blank Cell.
+****************************************************************/
+bool FindBlankCell( const Board & board, int & row, int & col )
+{
+	for( int i = 0; i < board.GetRows(); ++i )
+	{
+		const int r = ( board.GetRows() / 2 + i ) % board.GetRows();
+
+		for( int c = 0; c < board.GetCols(); ++c )
+		{
+			const Cell & cell = board.GetCell( r, c );
+
+			if( cell.IsBomb() == false && cell.GetNumBombs() == 0 )
+			{
+				row = r;
+				col = c;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/***************************************************************
+*   Purpose: Runs every scenario on one board size.
+*
+*     Entry: The board size.
+*
+*      Exit: The result lines are printed.
+****************************************************************/
+void RunBoard( const BoardSize & size )
+{
+	const double cells = static_cast<double>( size.rows ) * size.cols;
+	unsigned long long seed = SEED;
+	Board board( size.rows, size.cols, size.bombs );
+	int row = 0;
+	int col = 0;
+
+	board.PlaceBombs( SEED );
+
+	Measure( "PlaceBombs", size.name, cells, [&]()
+	{
+		Board fresh( size.rows, size.cols, size.bombs );
+
+		fresh.PlaceBombs( seed++ );
+		g_sink += fresh.GetCell( 0, 0 ).GetNumBombs();
+	} );
+
+	vector<int> bombs;
+
+	for( int r = 0; r < size.rows; ++r )
+		for( int c = 0; c < size.cols; ++c )
+			if( board.GetCell( r, c ).IsBomb() )
+				bombs.push_back( ( r * size.cols ) + c );
+
+	MeasureFresh( "SetNumber (per bomb)", size.name, cells, board, [&]( Board & b )
+	{
+		for( size_t i = 0; i < bombs.size(); ++i )
+			b.SetNumber( bombs[i] / size.cols, bombs[i] % size.cols );
+	} );
+
+	MeasureFresh( "SetNumbers (pass)", size.name, cells, board, [&]( Board & b )
+	{
+		b.SetNumbers();
+	} );
+
+	if( FindBlankCell( board, row, col ) )
+	{
+		Board probe( board );
+		const double revealed = probe.CascadeCells( row, col );
+
+		MeasureFresh( "CascadeCells", size.name, revealed, board, [&]( Board & b )
+		{
+			g_sink += b.CascadeCells( row, col );
+		} );
+
+		Measure( "LabelRegions", size.name, cells, [&]()
+		{
+			probe.LabelRegions();
+		} );
+
+		Board labelled( board );
+
+		labelled.LabelRegions();
+
+		MeasureFresh( "CascadeCells (labels)", size.name, revealed, labelled, [&]( Board & b )
+		{
+			g_sink += b.CascadeCells( row, col );
+		} );
+
+		Solver solver;
+
+		Measure( "Solver Attach", size.name, cells, [&]()
+		{
+			int r = 0;
+			int c = 0;
+
+			solver.Attach( probe );
+			g_sink += solver.NextSafe( r, c );
+		} );
+
+		MineProbability odds;
+		vector<double> grid;
+
+		odds.SetTimeBudget( 10 );
+
+		Measure( "MineProbability", size.name, cells, [&]()
+		{
+			g_sink += odds.Compute( probe, grid );
+		} );
+	}
+
+	MeasureFresh( "UncoverAllCells", size.name, cells, board, [&]( Board & b )
+	{
+		b.UncoverAllCells();
+	} );
+
+	Renderer renderer;
+
+	Measure( "Render (full)", size.name, cells, [&]()
+	{
+		renderer.Invalidate();
+		g_sink += renderer.BuildFrame( board );
+	} );
+
+	Measure( "Render (no change)", size.name, cells, [&]()
+	{
+		g_sink += renderer.BuildFrame( board );
+	} );
+
+	// The window is the same size on every Board
+	Viewport view;
+
+	view.SetScreenSize( VIEW_LINES, VIEW_COLUMNS );
+	view.SetCursor( size.rows / 2, size.cols / 2 );
+
+	Measure( "Viewport (full)", size.name, cells, [&]()
+	{
+		view.Invalidate();
+		g_sink += view.BuildFrame( board );
+	} );
+
+	Measure( "Viewport (no change)", size.name, cells, [&]()
+	{
+		g_sink += view.BuildFrame( board );
+	} );
+
+	// Loading maps the file, so it should not depend on the size
+	if( Selected( "Snapshot", size.name ) && board.Save( SNAPSHOT_FILE ) )
+	{
+		Measure( "Snapshot Save", size.name, cells, [&]()
+		{
+			g_sink += board.Save( SNAPSHOT_FILE );
+		} );
+
+		Measure( "Snapshot Load", size.name, cells, [&]()
+		{
+			Board loaded;
+
+			g_sink += loaded.Load( SNAPSHOT_FILE );
+			g_sink += loaded.GetCell( size.rows - 1, size.cols - 1 ).GetNumBombs();
+		} );
+
+		remove( SNAPSHOT_FILE );
+	}
+
+	// With a single bomb one click opens almost the whole board
+	string worst_name = string( size.name ) + "/1";
+	Board worst( size.rows, size.cols, 1 );
+
+	worst.PlaceBombs( SEED );
+
+	if( FindBlankCell( worst, row, col ) )
+	{
+		MeasureFresh( "CascadeCells (worst)", worst_name.c_str(), cells, worst,
+					  [&]( Board & b )
+		{
+			g_sink += b.CascadeCells( row, col );
+		} );
+
+		Board single( worst );
+
+		single.SetCascadeThreads( 1 );
+
+		MeasureFresh( "CascadeCells (serial)", worst_name.c_str(), cells, single,
+					  [&]( Board & b )
+		{
+			g_sink += b.CascadeCells( row, col );
+		} );
+
+		worst.LabelRegions();
+
+		MeasureFresh( "CascadeCells (labels)", worst_name.c_str(), cells, worst,
+					  [&]( Board & b )
+		{
+			g_sink += b.CascadeCells( row, col );
+		} );
+	}
+
+	// The same density kept in tiles that are made on first touch,
+	// opened from a first click in the middle
+	const int tile_bombs = static_cast<int>( size.bombs * ( ChunkedArray2D<Cell>::TILE_CELLS / cells ) );
+	Board chunked;
+
+	chunked.ResetChunked( size.rows, size.cols, tile_bombs );
+	chunked.PlaceBombs( SEED, size.rows / 2, size.cols / 2 );
+
+	const double opened = chunked.CascadeCells( size.rows / 2, size.cols / 2 );
+
+	Measure( "CascadeCells (chunked)", size.name, opened, [&]()
+	{
+		Board fresh;
+
+		fresh.ResetChunked( size.rows, size.cols, tile_bombs );
+		fresh.PlaceBombs( SEED, size.rows / 2, size.cols / 2 );
+		g_sink += fresh.CascadeCells( size.rows / 2, size.cols / 2 );
+	} );
+}
+
+/***************************************************************
+*   Purpose: Runs the bomb placement and cascade scenarios on the
+*			 FixedBoard of a preset, from the same seed and click
+*			 as RunBoard(), so the two can be compared line by line.
+*
+*     Entry: The board size. Nothing is run if it is not a preset.
+*
+*      Exit: The result lines are printed.
+****************************************************************/
+void RunFixedBoard( const BoardSize & size )
+{
+	const double cells = static_cast<double>( size.rows ) * size.cols;
+
+	DispatchFixedBoard( size.rows, size.cols, size.bombs, [&]( auto & board )
+	{
+		unsigned long long seed = SEED;
+		Board probe( size.rows, size.cols, size.bombs );
+		int row = 0;
+		int col = 0;
+
+		Measure( "PlaceBombs (fixed)", size.name, cells, [&]()
+		{
+			board.Reset();
+			board.PlaceBombs( seed++ );
+			g_sink += board.GetCell( 0, 0 ).GetNumBombs();
+		} );
+
+		probe.PlaceBombs( SEED );
+
+		if( FindBlankCell( probe, row, col ) == false )
+			return;
+
+		auto original = board;
+
+		original.Reset();
+		original.PlaceBombs( SEED );
+
+		const double revealed = probe.CascadeCells( row, col );
+
+		Measure( "CascadeCells (fixed)", size.name, revealed, [&]()
+		{
+			board = original;
+			g_sink += board.CascadeCells( row, col );
+		} );
+	} );
+}
+
+/***************************************************************
+*   Purpose: Times the containers on their own: reading every
+*			 element of an Array, and of an Array2D through Select(),
+*			 through the Row returned by operator[], through RowData()
+*			 and through its iterators.
+*
+*     Entry: The board size to use for the container size.
+*
+*      Exit: The result lines are printed.
+****************************************************************/
+void RunContainers( const BoardSize & size )
+{
+	const double cells = static_cast<double>( size.rows ) * size.cols;
+	Array<int> array( size.rows * size.cols );
+	Array2D<int> array2D( size.rows, size.cols );
+
+	for( int i = 0; i < size.rows * size.cols; ++i )
+		array[i] = i;
+
+	for( int r = 0; r < size.rows; ++r )
+		for( int c = 0; c < size.cols; ++c )
+			array2D.Select( r, c ) = r + c;
+
+	Measure( "Array[]", size.name, cells, [&]()
+	{
+		long long sum = 0;
+
+		for( int i = 0; i < size.rows * size.cols; ++i )
+			sum += array[i];
+
+		g_sink += sum;
+	} );
+
+	Measure( "Array2D Select", size.name, cells, [&]()
+	{
+		long long sum = 0;
+
+		for( int r = 0; r < size.rows; ++r )
+			for( int c = 0; c < size.cols; ++c )
+				sum += array2D.Select( r, c );
+
+		g_sink += sum;
+	} );
+
+	Measure( "Array2D[][] (Row)", size.name, cells, [&]()
+	{
+		long long sum = 0;
+
+		for( int r = 0; r < size.rows; ++r )
+			for( int c = 0; c < size.cols; ++c )
+				sum += array2D[r][c];
+
+		g_sink += sum;
+	} );
+
+	Measure( "Array2D RowData", size.name, cells, [&]()
+	{
+		long long sum = 0;
+
+		for( int r = 0; r < size.rows; ++r )
+		{
+			const int * row = array2D.RowData( r );
+
+			for( int c = 0; c < size.cols; ++c )
+				sum += row[c];
+		}
+
+		g_sink += sum;
+	} );
+
+	Measure( "Array2D range for", size.name, cells, [&]()
+	{
+		long long sum = 0;
+
+		for( int value : array2D )
+			sum += value;
+
+		g_sink += sum;
+	} );
+}
+
+int main( int argc, char * argv[] )
+{
+	const BoardSize sizes[] =
+	{
+		{ "Beginner", 10, 10, 10 },
+		{ "Intermediate", 16, 16, 40 },
+		{ "Expert", 16, 30, 100 },
+		{ "1k x 1k", 1000, 1000, 208333 },
+		{ "4k x 4k", 4000, 4000, 3333333 }
+	};
+
+	if( argc > 1 )
+		g_filter = argv[1];
+
+	printf( "%-22s %-14s %14s %14s %10s\n", "scenario", "board", "ns/op",
+			"cells/s", "allocs/op" );
+
+	for( size_t i = 0; i < sizeof( sizes ) / sizeof( sizes[0] ); ++i )
+	{
+		RunBoard( sizes[i] );
+		RunFixedBoard( sizes[i] );
+		RunContainers( sizes[i] );
+	}
+
+	return 0;
+}
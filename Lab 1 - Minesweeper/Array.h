@@ -9,11 +9,16 @@
 *		Also allocates memory for the array itself.
 *	Array( const Array & copy )
 *		Copy constructor for Array.
+*	Array( Array && move )
+*		Move constructor for Array. Takes over the other array's memory.
 *
 * METHODS:
 *	Array<T> & operator=( const Array & rhs )
 *		Overloads the assignment operator so that two Array objects can
-*		be assigned to each other.
+*		be assigned to each other. Reuses the memory already held when
+*		it is big enough.
+*	Array<T> & operator=( Array && rhs )
+*		Move assignment. Takes over the other array's memory.
 *	T &  operator[]( int index )
 *		Overloads the subscript operator so that we can manage this
 *		object and its exceptions ourselves.
@@ -27,7 +32,25 @@
 *	int  getLength() const
 *		Gets the length of this array.
 *	void setLength( int length )
-*		Sets the length of the array to something new.
+*		Sets the length of the array to something new. Shrinking keeps
+*		the memory, and growing past the capacity at least doubles it,
+*		so growing one element at a time costs amortized O(1).
+*	int  getCapacity() const
+*		Gets how many elements fit before the memory has to be replaced.
+*	void reserve( int capacity )
+*		Makes sure that at least this many elements fit without another
+*		allocation.
+*	void UseMemory( T * memory, int length )
+*		Makes the array use memory that belongs to someone else, such as
+*		a mapped file, instead of its own. That memory is never deleted.
+*	T * data()
+*	const T * data() const
+*		Gets a pointer to the first element so that the whole array can
+*		be walked without a bounds check on every element.
+*	T * begin() / end()
+*	const T * begin() / end() const
+*		Iterators over the elements, so the array can be used in a
+*		range based for loop. These are not bounds checked.
 *	~Array()
 *		Deallocates the memory given to m_array and sets the length and
 *		the starting index to 0.
@@ -36,6 +59,7 @@
 #define ARRAY_H
 
 #include <iostream>
+#include <utility>
 #include "Exception.h"
 
 using std::cout;
@@ -48,19 +72,34 @@ class Array
 		Array();
 		Array( int length, int start_index = 0 );
 		Array( const Array & copy );
+		Array( Array && move ) noexcept;
 		Array<T> & operator=( const Array & rhs );
+		Array<T> & operator=( Array && rhs ) noexcept;
 		T &  operator[]( int index );
 		const T &  operator[]( int index ) const;
 		int  getStartIndex() const;
 		void setStartIndex( int start_index );
 		int  getLength() const;
 		void setLength( int length );
+		int  getCapacity() const;
+		void reserve( int capacity );
+		void UseMemory( T * memory, int length );
+		T * data();
+		const T * data() const;
+		T * begin();
+		T * end();
+		const T * begin() const;
+		const T * end() const;
 		~Array();
 
 	private:
+		void Reallocate( int capacity );
+
 		T * m_array;
 		int m_length;
+		int m_capacity;
 		int m_start_index;
+		bool m_owned;    // False while the memory belongs to someone else
 };
 
 /***************************************************************
@@ -71,7 +110,8 @@ class Array
 *      Exit: None
 ****************************************************************/
 template<class T>
-Array<T>::Array() : m_array( nullptr ), m_length( 0 ), m_start_index( 0 )
+Array<T>::Array() : m_array( nullptr ), m_length( 0 ), m_capacity( 0 ), m_start_index( 0 ),
+					m_owned( true )
 { }
 
 /***************************************************************
@@ -84,7 +124,9 @@ Array<T>::Array() : m_array( nullptr ), m_length( 0 ), m_start_index( 0 )
 *      Exit: None
 ****************************************************************/
 template<class T>
-Array<T>::Array( int length, int start_index ) : m_array( nullptr ), m_length( length ), m_start_index( start_index )
+Array<T>::Array( int length, int start_index ) : m_array( nullptr ), m_length( length ),
+												 m_capacity( length ), m_start_index( start_index ),
+												 m_owned( true )
 {
 	m_array = new T [m_length];
 }
@@ -99,17 +141,41 @@ Array<T>::Array( int length, int start_index ) : m_array( nullptr ), m_length( l
 template<class T>
 Array<T>::Array( const Array & copy ) : m_array( nullptr ),
 										m_length( copy.m_length ),
-										m_start_index( copy.m_start_index )
+										m_capacity( copy.m_length ),
+										m_start_index( copy.m_start_index ),
+										m_owned( true )
 {
 	m_array = new T [copy.m_length];
 
-	for( int i = 0; i < ( m_length + m_start_index ); ++i )
+	for( int i = 0; i < m_length; ++i )
 		m_array[i] = copy.m_array[i];
 }
 
+/***************************************************************
+*   Purpose: Move constructor for Array. Takes over the memory of
+*			 the array passed in instead of copying it.
+*            
+*     Entry: The array object to be moved from.
+*            
+*      Exit: The other array is left empty.
+****************************************************************/
+template<class T>
+Array<T>::Array( Array && move ) noexcept : m_array( move.m_array ),
+											m_length( move.m_length ),
+											m_capacity( move.m_capacity ),
+											m_start_index( move.m_start_index ),
+											m_owned( move.m_owned )
+{
+	move.m_array = nullptr;
+	move.m_length = 0;
+	move.m_capacity = 0;
+	move.m_owned = true;
+}
+
 /***************************************************************
 *   Purpose: Overloads the assignment operator so that two Array
-*			 objects can be assigned to each other.
+*			 objects can be assigned to each other. The memory this
+*			 array already holds is reused when it is big enough.
 *            
 *     Entry: The right hand side of the assignment operator by
 *			 reference.
@@ -121,8 +187,15 @@ Array<T> & Array<T>::operator=( const Array & rhs )
 {
 	if( this != &rhs )
 	{
-		delete [] m_array;
-		m_array = new T [rhs.m_length];
+		if( m_capacity < rhs.m_length )
+		{
+			if( m_owned )
+				delete [] m_array;
+
+			m_array = new T [rhs.m_length];
+			m_capacity = rhs.m_length;
+			m_owned = true;
+		}
 
 		for( int i = 0; i < rhs.m_length; ++i )
 			m_array[i] = rhs.m_array[i];
@@ -134,6 +207,38 @@ Array<T> & Array<T>::operator=( const Array & rhs )
 	return *this;
 }
 
+/***************************************************************
+*   Purpose: Move assignment. Takes over the memory of the array
+*			 passed in instead of copying it.
+*            
+*     Entry: The right hand side of the assignment operator.
+*            
+*      Exit: Returns the new object by reference. The other array
+*			 is left empty.
+****************************************************************/
+template<class T>
+Array<T> & Array<T>::operator=( Array && rhs ) noexcept
+{
+	if( this != &rhs )
+	{
+		if( m_owned )
+			delete [] m_array;
+
+		m_array = rhs.m_array;
+		m_length = rhs.m_length;
+		m_capacity = rhs.m_capacity;
+		m_start_index = rhs.m_start_index;
+		m_owned = rhs.m_owned;
+
+		rhs.m_array = nullptr;
+		rhs.m_length = 0;
+		rhs.m_capacity = 0;
+		rhs.m_owned = true;
+	}
+
+	return *this;
+}
+
 /***************************************************************
 *   Purpose: Overloads the subscript operator so that we can
 *			 manage this object and its exceptions ourselves.
@@ -211,57 +316,203 @@ int Array<T>::getLength() const
 
 /***************************************************************
 *   Purpose: Sets the length of the array to something new.
+*			 Shrinking keeps the memory for later. Growing past the
+*			 capacity at least doubles it, so a run of small growths
+*			 only copies each element a constant number of times.
 *            
 *     Entry: The new length of the array.
 *            
-*      Exit: None
+*      Exit: The first elements keep their values. Elements added
+*			 by growing are default values.
 ****************************************************************/
 template<class T>
 void Array<T>::setLength( int length )
 {
-	T * temp;
-
-	if( m_length == 0 )
+	if( length < 0 )
+		throw Exception( "ERROR: Cannot make an array with a negative length" );
+	else if( length == m_length && m_length != 0 )
+		cout << "The array is already " << length << " elements big." << endl;
+	else if( length > m_capacity )
 	{
-		temp = new T [length];
-		m_length = length;
+		int capacity = m_capacity * 2;
 
-		delete [] m_array;
+		if( capacity < length )
+			capacity = length;
+
+		Reallocate( capacity );
 
-		m_array = temp;
+		m_length = length;
 	}
-	else if( m_length < length )
+	else
 	{
-		temp = new T [m_length + ( length - m_length )];
-
-		for( int i = 0; i < length; ++i )
-		{
-			temp[i] = m_array[i];
-		}
+		for( int i = m_length; i < length; ++i )
+			m_array[i] = T();
 
 		m_length = length;
+	}
+}
+
+/***************************************************************
+*   Purpose: Gets how many elements fit before the memory has to
+*			 be replaced.
+*            
+*     Entry: None
+*            
+*      Exit: Returns the capacity.
+****************************************************************/
+template<class T>
+int Array<T>::getCapacity() const
+{
+	return m_capacity;
+}
 
+/***************************************************************
+*   Purpose: Makes sure that at least this many elements fit
+*			 without another allocation.
+*            
+*     Entry: The capacity wanted.
+*            
+*      Exit: The length and elements are unchanged.
+****************************************************************/
+template<class T>
+void Array<T>::reserve( int capacity )
+{
+	if( capacity > m_capacity )
+		Reallocate( capacity );
+}
+
+/***************************************************************
+*   Purpose: Makes the array use memory that belongs to someone
+*			 else, such as a mapped file, so that its elements do
+*			 not have to be copied in. The memory is never deleted
+*			 by the array, and must stay valid for as long as the
+*			 array uses it. Growing past it moves the elements into
+*			 memory of the array's own.
+*            
+*     Entry: The memory, which holds length elements.
+*            
+*      Exit: The array's own memory is released. The elements are
+*			 the ones in the memory given.
+****************************************************************/
+template<class T>
+void Array<T>::UseMemory( T * memory, int length )
+{
+	if( m_owned )
 		delete [] m_array;
-		
-		m_array = temp;
-	}
-	else if( m_length > length && length >= 0 )
-	{
-		temp = new T [m_length - ( m_length - length )];
 
-		for( int i = 0; i < length; ++i )
-			temp[i] = m_array[i];
+	m_array = memory;
+	m_length = length;
+	m_capacity = length;
+	m_owned = false;
+}
 
-		m_length = length;
+/***************************************************************
+*   Purpose: Replaces the memory with a block of the given size,
+*			 moving the current elements into it.
+*            
+*     Entry: The new capacity, which is at least the length.
+*            
+*      Exit: The elements past the length are default values.
+****************************************************************/
+template<class T>
+void Array<T>::Reallocate( int capacity )
+{
+	T * temp = new T [capacity];
+
+	for( int i = 0; i < m_length; ++i )
+		temp[i] = std::move( m_array[i] );
 
+	if( m_owned )
 		delete [] m_array;
 
-		m_array = temp;
-	}
-	else if( length < 0 )
-		throw Exception( "ERROR: Cannot make an array with a negative length" );
-	else
-		cout << "The array is already " << length << " elements big." << endl;
+	m_array = temp;
+	m_capacity = capacity;
+	m_owned = true;
+}
+
+/***************************************************************
+*   Purpose: Gets a pointer to the first element so that the
+*			 whole array can be walked without a bounds check on
+*			 every element.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to the first element, or nullptr if
+*			 the array is empty.
+****************************************************************/
+template<class T>
+T * Array<T>::data()
+{
+	return m_array;
+}
+
+/***************************************************************
+*   Purpose: Gets a pointer to the first element of a CONSTANT
+*			 array.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to the first element, or nullptr if
+*			 the array is empty.
+****************************************************************/
+template<class T>
+const T * Array<T>::data() const
+{
+	return m_array;
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to the first element.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to the first element.
+****************************************************************/
+template<class T>
+T * Array<T>::begin()
+{
+	return m_array;
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to one past the last element.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to one past the last element.
+****************************************************************/
+template<class T>
+T * Array<T>::end()
+{
+	return m_array + m_length;
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to the first element of a CONSTANT
+*			 array.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to the first element.
+****************************************************************/
+template<class T>
+const T * Array<T>::begin() const
+{
+	return m_array;
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to one past the last element of a
+*			 CONSTANT array.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to one past the last element.
+****************************************************************/
+template<class T>
+const T * Array<T>::end() const
+{
+	return m_array + m_length;
 }
 
 /***************************************************************
@@ -275,8 +526,11 @@ void Array<T>::setLength( int length )
 template<class T>
 Array<T>::~Array()
 {
-	delete [] m_array;
+	if( m_owned )
+		delete [] m_array;
+
 	m_length = 0;
+	m_capacity = 0;
 	m_start_index = 0;
 }
 
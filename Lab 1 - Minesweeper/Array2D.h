@@ -9,11 +9,15 @@
 *			 columns that are passed in.
 *	Array2D( const Array2D & copy )
 *		Copy constructor for Array2D.
+*	Array2D( Array2D && move )
+*		Move constructor for Array2D. Takes over the other array's memory.
 *
 * METHODS:
 *	Array2D & operator=( const Array2D & rhs )
 *		Overloads the assignment operator so that two Array2D objects can
 *		be assigned to each other.
+*	Array2D & operator=( Array2D && rhs )
+*		Move assignment. Takes over the other array's memory.
 *	const Row<T> operator[]( int index ) const
 *		Overloads the subscript operator so that we can manage the 
 *		CONSTANT objects and their exceptions ourselves.
@@ -27,13 +31,37 @@
 *	int getColumn() const
 *		Gets the total number of columns there are.
 *	void setColumn( int columns )
-*		Sets the total number of columns to a new amount.
+*		Sets the total number of columns to a new amount. The rows are
+*		shifted inside the existing memory, which only grows when it is
+*		too small.
+*	void Reset( int rows, int columns )
+*		Sets both sizes at once and resets every element to its default
+*		value, reusing the memory when it is big enough.
+*	void UseMemory( T * memory, int rows, int columns )
+*		Makes the array use rows * columns elements of memory that belong
+*		to someone else, such as a mapped file, stored row by row.
 *	const T & Select( int row, int column ) const
 *		Gets the data from the 1D array according to the row and column that
 *		is passed in. *For CONSTANT objects.
 *	T & Select( int row, int column )
 *		Gets the data from the 1D array according to the row and column that
 *		is passed in.
+*	const T & SelectUnchecked( int row, int column ) const
+*	T & SelectUnchecked( int row, int column )
+*		Same as Select(), but the row and column are only checked in debug
+*		builds. For loops that already know they are on the array.
+*	T * RowData( int row )
+*	const T * RowData( int row ) const
+*		Gets a pointer to the first element of a row. The columns of the
+*		row follow it in memory. The row is only checked in debug builds.
+*	T * data()
+*	const T * data() const
+*		Gets a pointer to the first element. Every row follows the one
+*		before it in memory.
+*	T * begin() / end()
+*	const T * begin() / end() const
+*		Iterators over every element in row order, so the array can be
+*		used in a range based for loop.
 *	~Array2D()
 *		Sets the total columns and rows to 0.
 *************************************************************************/
@@ -42,6 +70,7 @@
 #include "Array.h"
 #include "Exception.h"
 #include "Row.h"
+#include <cassert>
 #include <iostream>
 
 using std::cout;
@@ -55,15 +84,29 @@ class Array2D
 		Array2D();
 		Array2D( int row, int col = 0 );
 		Array2D( const Array2D & copy );
+		Array2D( Array2D && move ) noexcept;
 		Array2D & operator=( const Array2D & rhs );
+		Array2D & operator=( Array2D && rhs ) noexcept;
 		const Row<T> operator[]( int index ) const;
 		Row<T> operator[]( int index );
 		int getRow() const;
 		void setRow( int rows );
 		int getColumn() const;
 		void setColumn( int columns );
+		void Reset( int rows, int columns );
+		void UseMemory( T * memory, int rows, int columns );
 		const T & Select( int row, int column ) const;
 		T & Select( int row, int column );
+		const T & SelectUnchecked( int row, int column ) const;
+		T & SelectUnchecked( int row, int column );
+		T * RowData( int row );
+		const T * RowData( int row ) const;
+		T * data();
+		const T * data() const;
+		T * begin();
+		T * end();
+		const T * begin() const;
+		const T * end() const;
 		~Array2D();
 
 	private:
@@ -92,7 +135,7 @@ Array2D<T>::Array2D() : m_array( 0 ), m_row( 0 ), m_col( 0 )
 *      Exit: None
 ****************************************************************/
 template<class T>
-Array2D<T>::Array2D( int row, int col = 0 ) : m_array( row * col ), m_row( row ), m_col( col )
+Array2D<T>::Array2D( int row, int col ) : m_array( row * col ), m_row( row ), m_col( col )
 { }
 
 /***************************************************************
@@ -108,6 +151,23 @@ Array2D<T>::Array2D( const Array2D & copy ) : m_array( copy.m_array ),
 											  m_col( copy.m_col )
 { }
 
+/***************************************************************
+*   Purpose: Move constructor for Array2D. Takes over the memory
+*			 of the Array2D passed in instead of copying it.
+*            
+*     Entry: The Array2D object to be moved from.
+*            
+*      Exit: The other Array2D is left with no rows or columns.
+****************************************************************/
+template<class T>
+Array2D<T>::Array2D( Array2D && move ) noexcept : m_array( std::move( move.m_array ) ),
+												  m_row( move.m_row ),
+												  m_col( move.m_col )
+{
+	move.m_row = 0;
+	move.m_col = 0;
+}
+
 /***************************************************************
 *   Purpose: Overloads the assignment operator so that two Array2D
 *			 objects can be assigned to each other.
@@ -129,6 +189,31 @@ Array2D<T> & Array2D<T>::operator=( const Array2D & rhs )
 	return *this;
 }
 
+/***************************************************************
+*   Purpose: Move assignment. Takes over the memory of the Array2D
+*			 passed in instead of copying it.
+*            
+*     Entry: The right hand side of the assignment operator.
+*            
+*      Exit: Returns a reference to this Array2D. The other one is
+*			 left with no rows or columns.
+****************************************************************/
+template<class T>
+Array2D<T> & Array2D<T>::operator=( Array2D && rhs ) noexcept
+{
+	if( this != &rhs )
+	{
+		m_array = std::move( rhs.m_array );
+		m_col = rhs.m_col;
+		m_row = rhs.m_row;
+
+		rhs.m_col = 0;
+		rhs.m_row = 0;
+	}
+
+	return *this;
+}
+
 /***************************************************************
 *   Purpose: Overloads the subscript operator so that we can
 *			 manage the CONSTANT objects and their exceptions
@@ -209,61 +294,109 @@ int Array2D<T>::getColumn() const
 
 /***************************************************************
 *   Purpose: Sets the total number of columns to a new amount.
+*			 The rows are shifted inside the existing memory rather
+*			 than copied into a temporary array: when the rows get
+*			 wider they are moved starting from the last one, and
+*			 when they get narrower starting from the first one, so
+*			 a row is never overwritten before it has been moved.
 *            
 *     Entry: The new number of columns desired.
 *            
-*      Exit: None
+*      Exit: Every row keeps its first columns. Columns added are
+*			 default values.
 ****************************************************************/
 template<class T>
 void Array2D<T>::setColumn( int columns )
 {
-	Array<T> temp;
-	int temp_indx = 0;
-	int old_indx = 0;
-
 	if( columns < 0 )
 		throw Exception( "ERROR: Cannot have negative amount of columns" );
 
-	temp.setLength( m_row * columns );
-
 	if( m_col < columns ) // Making columns larger
 	{
-		for( int i = 0; i < m_row; ++i ) // Loops for however many rows there are
+		if( m_row * columns > 0 )
+			m_array.setLength( m_row * columns );
+
+		T * data = m_array.data();
+
+		for( int i = m_row - 1; i >= 0; --i ) // Loops for however many rows there are, last first
 		{
-			for( int j = 0; j < m_col; ++j ) // Loops for however many columns per row there are in the old array
-			{
-				temp[temp_indx] = m_array[old_indx];
-				temp_indx++;
-				old_indx++;
-			}
-
-			temp_indx += ( columns - m_col );
+			for( int j = columns - 1; j >= m_col; --j ) // The new columns of the row
+				data[( i * columns ) + j] = T();
+
+			for( int j = m_col - 1; j >= 0; --j ) // Loops for however many columns per row there are in the old array
+				data[( i * columns ) + j] = std::move( data[( i * m_col ) + j] );
 		}
 
-		m_array = temp;
 		m_col = columns;
 	}
 	else if( m_col > columns ) // Making columns smaller
 	{
+		T * data = m_array.data();
+
 		for( int i = 0; i < m_row; ++i ) // Loops for however many rows there are
 		{
-			for( int j = 0; j < columns; ++j ) // Loops for however many columns per row there are in the old array
-			{
-				temp[temp_indx] = m_array[old_indx];
-				temp_indx++;
-				old_indx++;
-			}
-
-			old_indx += ( m_col - columns );
+			for( int j = 0; j < columns; ++j ) // Loops for however many columns per row there are in the new array
+				data[( i * columns ) + j] = std::move( data[( i * m_col ) + j] );
 		}
 
-		m_array = temp;
+		m_array.setLength( m_row * columns );
 		m_col = columns;
 	}
 	else
 		cout << "The array already has " << columns << " columns." << endl;
 }
 
+/***************************************************************
+*   Purpose: Sets the number of rows and columns at once and
+*			 resets every element to its default value. The memory
+*			 is reused when it is big enough, so an Array2D can be
+*			 refilled over and over without allocating.
+*            
+*     Entry: The new number of rows and columns.
+*            
+*      Exit: Every element is a default value.
+****************************************************************/
+template<class T>
+void Array2D<T>::Reset( int rows, int columns )
+{
+	if( rows < 0 || columns < 0 )
+		throw Exception( "ERROR: Cannot have negative amount of rows or columns" );
+
+	m_array.reserve( rows * columns );
+
+	T * data = m_array.data();
+
+	for( int i = 0; i < rows * columns && i < m_array.getLength(); ++i )
+		data[i] = T();
+
+	if( m_array.getLength() != rows * columns )
+		m_array.setLength( rows * columns );
+
+	m_row = rows;
+	m_col = columns;
+}
+
+/***************************************************************
+*   Purpose: Makes the array use memory that belongs to someone
+*			 else, such as a mapped file, instead of copying the
+*			 elements in. See Array::UseMemory().
+*            
+*     Entry: The memory, holding rows * columns elements row by
+*			 row, and the number of rows and columns.
+*            
+*      Exit: The elements are the ones in the memory given.
+****************************************************************/
+template<class T>
+void Array2D<T>::UseMemory( T * memory, int rows, int columns )
+{
+	if( rows < 0 || columns < 0 )
+		throw Exception( "ERROR: Cannot have negative amount of rows or columns" );
+
+	m_array.UseMemory( memory, rows * columns );
+	m_row = rows;
+	m_col = columns;
+}
+
 /***************************************************************
 *   Purpose: Gets the data from the 1D array according to the
 *			 row and column that is passed in. *For CONSTANT
@@ -293,6 +426,154 @@ T & Array2D<T>::Select( int row, int column )
 	return m_array[( row * m_col ) + column];
 }
 
+/***************************************************************
+*   Purpose: Same as Select(), but the row and column are only
+*			 checked in debug builds. *For CONSTANT objects.
+*            
+*     Entry: The row and column of the desired index, which must
+*			 be inside the array.
+*            
+*      Exit: Returns data at "m_array[row][column]".
+****************************************************************/
+template<class T>
+const T & Array2D<T>::SelectUnchecked( int row, int column ) const
+{
+	assert( row >= 0 && row < m_row && column >= 0 && column < m_col );
+
+	return m_array.data()[( row * m_col ) + column];
+}
+
+/***************************************************************
+*   Purpose: Same as Select(), but the row and column are only
+*			 checked in debug builds.
+*            
+*     Entry: The row and column of the desired index, which must
+*			 be inside the array.
+*            
+*      Exit: Returns data at "m_array[row][column]".
+****************************************************************/
+template<class T>
+T & Array2D<T>::SelectUnchecked( int row, int column )
+{
+	assert( row >= 0 && row < m_row && column >= 0 && column < m_col );
+
+	return m_array.data()[( row * m_col ) + column];
+}
+
+/***************************************************************
+*   Purpose: Gets a pointer to the first element of a row. The
+*			 rest of the row's columns follow it in memory.
+*            
+*     Entry: The row, which must be inside the array.
+*            
+*      Exit: Returns a pointer to "m_array[row][0]".
+****************************************************************/
+template<class T>
+T * Array2D<T>::RowData( int row )
+{
+	assert( row >= 0 && row < m_row );
+
+	return m_array.data() + ( row * m_col );
+}
+
+/***************************************************************
+*   Purpose: Gets a pointer to the first element of a row of a
+*			 CONSTANT array.
+*            
+*     Entry: The row, which must be inside the array.
+*            
+*      Exit: Returns a pointer to "m_array[row][0]".
+****************************************************************/
+template<class T>
+const T * Array2D<T>::RowData( int row ) const
+{
+	assert( row >= 0 && row < m_row );
+
+	return m_array.data() + ( row * m_col );
+}
+
+/***************************************************************
+*   Purpose: Gets a pointer to the first element. Every row
+*			 follows the one before it in memory.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to "m_array[0][0]".
+****************************************************************/
+template<class T>
+T * Array2D<T>::data()
+{
+	return m_array.data();
+}
+
+/***************************************************************
+*   Purpose: Gets a pointer to the first element of a CONSTANT
+*			 array.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to "m_array[0][0]".
+****************************************************************/
+template<class T>
+const T * Array2D<T>::data() const
+{
+	return m_array.data();
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to the first element.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to the first element.
+****************************************************************/
+template<class T>
+T * Array2D<T>::begin()
+{
+	return m_array.data();
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to one past the last element.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to one past the last element.
+****************************************************************/
+template<class T>
+T * Array2D<T>::end()
+{
+	return m_array.data() + ( m_row * m_col );
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to the first element of a CONSTANT
+*			 array.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to the first element.
+****************************************************************/
+template<class T>
+const T * Array2D<T>::begin() const
+{
+	return m_array.data();
+}
+
+/***************************************************************
+*   Purpose: Gets an iterator to one past the last element of a
+*			 CONSTANT array.
+*            
+*     Entry: None
+*            
+*      Exit: Returns a pointer to one past the last element.
+****************************************************************/
+template<class T>
+const T * Array2D<T>::end() const
+{
+	return m_array.data() + ( m_row * m_col );
+}
+
 /***************************************************************
 *   Purpose: Sets the total columns and rows to 0.
 *            
@@ -1,13 +1,71 @@
-#include <Windows.h>
-#include <stdlib.h> // For srand()
-#include <time.h>   // For time() to use as a seed for srand()
+#include <time.h>   // For time() to mix into the seed for PlaceBombs()
+#include <algorithm>
+#include <cassert>
+#include <climits>  // For INT_MAX
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <random>   // For std::random_device
+#include <thread>   // For std::thread::hardware_concurrency
 #include "Board.h"
+#include "Journal.h"
+#include "ParallelCascade.h"
+#include "Random.h"
+#include "Terminal.h"
+#include "ZeroRegions.h"
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#define BOARD_USE_AVX2
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define BOARD_USE_SSE2
+#endif
 
 using std::cout;
 using std::endl;
 using std::cin;
 
+// Side of a tile on a chunked Board
+const int TILE_SIZE = ChunkedArray2D<Cell>::TILE_SIZE;
+
+// Cells a cascade uncovers on the calling thread before the rest of it
+// is handed to ParallelCascade
+const int PARALLEL_CASCADE_CELLS = 1 << 16;
+
+// What GetCell() returns for a Cell in a tile that has not been made
+const Cell UNEXPLORED_CELL;
+
+// The start of a snapshot file. It is followed by one byte per Cell,
+// row by row, or for a chunked Board by each stored tile: its row and
+// column as two ints and then its Cells.
+struct SnapshotHeader
+{
+	char magic[4];
+	unsigned int version;
+	unsigned int chunked;
+	int rows;
+	int cols;
+	int bombs;
+	unsigned long long seed;
+	int num_covered;
+	int num_flags;
+	int num_revealed;
+	int lost;
+	int safe_row;
+	int safe_col;
+	int loaded_bombs;
+	int num_tiles;
+};
+
+static_assert( sizeof( SnapshotHeader ) == 64, "The snapshot header must stay 64 bytes" );
+
+const char SNAPSHOT_MAGIC[4] = { 'M', 'S', 'W', 'P' };
+const unsigned int SNAPSHOT_VERSION = 1;
+const unsigned long long SNAPSHOT_TILE_BYTES = ( 2 * sizeof( int ) ) + ChunkedArray2D<Cell>::TILE_CELLS;
+
 /***************************************************************
 *   Purpose: Default constructor for Board.
 *            
@@ -16,7 +74,11 @@ using std::cin;
 *            
 *      Exit: None
 ****************************************************************/
-Board::Board() : m_cells( 0, 0 ), m_bombs( 0 )
+Board::Board() : m_cells( 0, 0 ), m_chunked( false ), m_bombs( 0 ), m_seed( 0 ),
+				 m_safe_row( -1 ), m_safe_col( -1 ), m_loaded_bombs( 0 ),
+				 m_num_covered( 0 ), m_num_flags( 0 ), m_num_revealed( 0 ),
+				 m_lost( false ), m_track_changes( false ), m_cascade_threads( 0 ),
+				 m_journal( nullptr )
 { }
 
 /***************************************************************
@@ -29,37 +91,233 @@ Board::Board() : m_cells( 0, 0 ), m_bombs( 0 )
 *            
 *      Exit: None
 ****************************************************************/
-Board::Board( int rows, int cols, int bombs ) : m_cells( rows, cols ), m_bombs( bombs )
+Board::Board( int rows, int cols, int bombs ) : m_cells( rows, cols ), m_chunked( false ),
+												m_bombs( bombs ), m_seed( 0 ),
+												m_safe_row( -1 ), m_safe_col( -1 ),
+												m_loaded_bombs( 0 ),
+												m_num_covered( rows * cols ),
+												m_num_flags( 0 ), m_num_revealed( 0 ),
+												m_lost( false ), m_track_changes( false ),
+												m_cascade_threads( 0 ), m_journal( nullptr )
 { }
 
 /***************************************************************
 *   Purpose: Copy constructor for Board.
 ****************************************************************/
 Board::Board( const Board & copy ) : m_cells( copy.m_cells ),
-									 m_bombs( copy.m_bombs )
+									 m_tiles( copy.m_tiles ),
+									 m_chunked( copy.m_chunked ),
+									 m_bombs( copy.m_bombs ),
+									 m_seed( copy.m_seed ),
+									 m_safe_row( copy.m_safe_row ),
+									 m_safe_col( copy.m_safe_col ),
+									 m_loaded_bombs( copy.m_loaded_bombs ),
+									 m_num_covered( copy.m_num_covered ),
+									 m_num_flags( copy.m_num_flags ),
+									 m_num_revealed( copy.m_num_revealed ),
+									 m_lost( copy.m_lost ),
+									 m_track_changes( copy.m_track_changes ),
+									 m_changes( copy.m_changes ),
+									 m_cascade_threads( copy.m_cascade_threads ),
+									 m_regions( copy.m_regions ),
+									 m_journal( nullptr )
 { }
 
+/***************************************************************
+*   Purpose: Move constructor for Board. Takes over the Cells of
+*			 the Board passed in instead of copying them.
+****************************************************************/
+Board::Board( Board && move ) noexcept : m_cells( std::move( move.m_cells ) ),
+										 m_tiles( std::move( move.m_tiles ) ),
+										 m_chunked( move.m_chunked ),
+										 m_bombs( move.m_bombs ),
+										 m_seed( move.m_seed ),
+										 m_safe_row( move.m_safe_row ),
+										 m_safe_col( move.m_safe_col ),
+										 m_loaded_bombs( move.m_loaded_bombs ),
+										 m_num_covered( move.m_num_covered ),
+										 m_num_flags( move.m_num_flags ),
+										 m_num_revealed( move.m_num_revealed ),
+										 m_lost( move.m_lost ),
+										 m_track_changes( move.m_track_changes ),
+										 m_changes( std::move( move.m_changes ) ),
+										 m_cascade( std::move( move.m_cascade ) ),
+										 m_cascade_threads( move.m_cascade_threads ),
+										 m_regions( std::move( move.m_regions ) ),
+										 m_snapshot( std::move( move.m_snapshot ) ),
+										 m_journal( move.m_journal )
+{
+	move.m_journal = nullptr;
+}
+
 /***************************************************************
 *   Purpose: Overloads the assignment operator so that two Board 
-*			 objects can be assigned to each other.
+*			 objects can be assigned to each other. The memory for
+*			 this Board's Cells is reused when it is big enough.
 ****************************************************************/
 Board & Board::operator=( const Board & rhs )
 {
 	if( this != &rhs )
 	{
 		m_cells = rhs.m_cells;
+		m_tiles = rhs.m_tiles;
+		m_chunked = rhs.m_chunked;
+		m_bombs = rhs.m_bombs;
+		m_seed = rhs.m_seed;
+		m_safe_row = rhs.m_safe_row;
+		m_safe_col = rhs.m_safe_col;
+		m_loaded_bombs = rhs.m_loaded_bombs;
+		m_num_covered = rhs.m_num_covered;
+		m_num_flags = rhs.m_num_flags;
+		m_num_revealed = rhs.m_num_revealed;
+		m_lost = rhs.m_lost;
+		m_track_changes = rhs.m_track_changes;
+		m_changes = rhs.m_changes;
+		m_cascade_threads = rhs.m_cascade_threads;
+		m_regions = rhs.m_regions;
+	}
+
+	return *this;
+}
+
+/***************************************************************
+*   Purpose: Move assignment. Takes over the Cells of the Board
+*			 passed in instead of copying them.
+****************************************************************/
+Board & Board::operator=( Board && rhs ) noexcept
+{
+	if( this != &rhs )
+	{
+		m_cells = std::move( rhs.m_cells );
+		m_tiles = std::move( rhs.m_tiles );
+		m_chunked = rhs.m_chunked;
 		m_bombs = rhs.m_bombs;
+		m_seed = rhs.m_seed;
+		m_safe_row = rhs.m_safe_row;
+		m_safe_col = rhs.m_safe_col;
+		m_loaded_bombs = rhs.m_loaded_bombs;
+		m_num_covered = rhs.m_num_covered;
+		m_num_flags = rhs.m_num_flags;
+		m_num_revealed = rhs.m_num_revealed;
+		m_lost = rhs.m_lost;
+		m_track_changes = rhs.m_track_changes;
+		m_changes = std::move( rhs.m_changes );
+		m_cascade = std::move( rhs.m_cascade );
+		m_cascade_threads = rhs.m_cascade_threads;
+		m_regions = std::move( rhs.m_regions );
+		m_snapshot = std::move( rhs.m_snapshot );
+		m_journal = rhs.m_journal;
+
+		rhs.m_journal = nullptr;
 	}
 
 	return *this;
 }
 
+/***************************************************************
+*   Purpose: Turns the Board into a new, empty Board of the given
+*			 size, the same as constructing a new one but reusing
+*			 the memory for the Cells when it is big enough.
+*            
+*     Entry: The rows, columns and number of bombs.
+*            
+*      Exit: Every Cell is covered with no bomb, flag or number.
+****************************************************************/
+void Board::Reset( int rows, int cols, int bombs )
+{
+	m_cells.Reset( rows, cols );
+	m_tiles.Reset( 0, 0 );
+	m_chunked = false;
+	m_bombs = bombs;
+	m_seed = 0;
+	m_safe_row = -1;
+	m_safe_col = -1;
+	m_loaded_bombs = 0;
+	m_num_covered = rows * cols;
+	m_num_flags = 0;
+	m_num_revealed = 0;
+	m_lost = false;
+	m_changes.clear();
+	m_regions.reset();
+}
+
+/***************************************************************
+*   Purpose: Turns the Board into a new, empty chunked Board. The
+*			 Cells are kept in tiles that are only made the first
+*			 time play touches them, each with its bombs laid out
+*			 from the seed and the tile's position, so a tile that
+*			 is never reached costs nothing and the memory grows
+*			 with the area explored rather than the size.
+*            
+*     Entry: The rows, columns and the number of bombs in each full
+*			 tile. Tiles cut off by the edge get the same share.
+*            
+*      Exit: No tile is stored. PlaceBombs() picks the seed.
+*			 Changes are no longer tracked.
+****************************************************************/
+void Board::ResetChunked( int rows, int cols, int tile_bombs )
+{
+	try
+	{
+		if( tile_bombs < 0 || tile_bombs > ChunkedArray2D<Cell>::TILE_CELLS - 9 )
+			throw Exception( "ERROR: More bombs than cells in a tile" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		tile_bombs = 0;
+	}
+
+	m_cells.Reset( 0, 0 );
+	m_tiles.Reset( rows, cols );
+	m_chunked = true;
+	m_bombs = tile_bombs;
+	m_seed = 0;
+	m_safe_row = -1;
+	m_safe_col = -1;
+	m_loaded_bombs = 0;
+	m_num_covered = 0;
+	m_num_flags = 0;
+	m_num_revealed = 0;
+	m_lost = false;
+	m_track_changes = false;
+	m_changes.clear();
+	m_regions.reset();
+}
+
+/***************************************************************
+*   Purpose: Tells whether the Board keeps its Cells in tiles.
+*
+*     Entry: None
+*
+*      Exit: Returns true if ResetChunked() set it up.
+****************************************************************/
+bool Board::IsChunked() const
+{
+	return m_chunked;
+}
+
+/***************************************************************
+*   Purpose: Returns how many tiles of a chunked Board have been
+*			 made, which is what its memory grows with.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of stored tiles.
+****************************************************************/
+int Board::GetNumTiles() const
+{
+	return m_tiles.getNumTiles();
+}
+
 /***************************************************************
 *   Purpose: This method sets the total number of rows on the Board.
 ****************************************************************/
 void Board::SetRows( int rows )
 {
 	m_cells.setRow( rows );
+	m_regions.reset();
+	RecountCells();
 }
 
 /***************************************************************
@@ -68,6 +326,8 @@ void Board::SetRows( int rows )
 void Board::SetCols( int cols )
 {
 	m_cells.setColumn( cols );
+	m_regions.reset();
+	RecountCells();
 }
 
 /***************************************************************
@@ -79,12 +339,23 @@ void Board::SetBombs( int bombs )
 	m_bombs = bombs;
 }
 
+/***************************************************************
+*   Purpose: This method returns the total number of bombs on the Board.
+****************************************************************/
+int Board::GetBombs() const
+{
+	return m_bombs;
+}
+
 /***************************************************************
 *   Purpose: This method returns the total number of rows that the Board
 *			 currently has.
 ****************************************************************/
 int Board::GetRows() const
 {
+	if( m_chunked )
+		return m_tiles.getRow();
+
 	return m_cells.getRow();
 }
 
@@ -92,107 +363,90 @@ int Board::GetRows() const
 *   Purpose: This method returns the total number of columns that the Board
 *			 currently has.
 ****************************************************************/
-int Board::GetCols()
+int Board::GetCols() const
 {
+	if( m_chunked )
+		return m_tiles.getColumn();
+
 	return m_cells.getColumn();
 }
 
 /***************************************************************
-*   Purpose: Increases the bomb count for the cells surrounding
-*			 this bomb.
+*   Purpose: This method returns the Cell at the given row and
+*			 column so that its visible state can be read without
+*			 going through the console.
 *            
-*     Entry: The row and column of the bomb.
+*     Entry: The row and column of the Cell, which must be on the
+*			 Board. They are only checked in debug builds.
 *            
-*      Exit: All cells surrounding the bomb will have their bomb
-*			 count increased by one.
+*      Exit: Returns the Cell by constant reference.
 ****************************************************************/
-void Board::SetNumber( int r, int c )
+const Cell & Board::GetCell( int row, int col ) const
 {
-	try
+	if( m_chunked )
 	{
-		//right
-		if( c < ( m_cells.getColumn() - 1 ) &&
-			m_cells[r][c + 1].IsBomb() == false )
-		{
-			m_cells[r][c + 1].SetNumBombs(m_cells[r][c + 1].GetNumBombs() + 1);
-		}
-
-		//top right
-		if( r > 0 && c < ( m_cells.getColumn() - 1 ) &&
-			m_cells[r - 1][c + 1].IsBomb() == false )
-		{
-			m_cells[r-1][c+1].SetNumBombs(m_cells[r-1][c+1].GetNumBombs() + 1);
-		}
+		const Cell * tile = m_tiles.FindTile( row / TILE_SIZE, col / TILE_SIZE );
 
-		//top middle
-		if( r > 0 && m_cells[r - 1][c].IsBomb() == false )
-			m_cells[r - 1][c].SetNumBombs(m_cells[r - 1][c].GetNumBombs() + 1);
+		if( tile == nullptr )
+			return UNEXPLORED_CELL;
 
-		//top left
-		if( r > 0 && c > 0 && m_cells[r - 1][c - 1].IsBomb() == false )
-			m_cells[r-1][c-1].SetNumBombs(m_cells[r-1][c-1].GetNumBombs() + 1);
-
-		//left
-		if( c > 0 && m_cells[r][c - 1].IsBomb() == false )
-			m_cells[r][c - 1].SetNumBombs(m_cells[r][c - 1].GetNumBombs() + 1);
+		return tile[( ( row % TILE_SIZE ) * TILE_SIZE ) + ( col % TILE_SIZE )];
+	}
 
-		//bottom left
-		if(r < ( m_cells.getRow() - 1 ) && c > 0 &&
-		   m_cells[r + 1][c - 1].IsBomb() == false )
-		{
-			m_cells[r+1][c-1].SetNumBombs(m_cells[r+1][c-1].GetNumBombs() + 1);
-		}
+	return m_cells.SelectUnchecked( row, col );
+}
 
-		//bottom middle
-		if( r < ( m_cells.getRow() - 1 ) &&
-			m_cells[r + 1][c].IsBomb() == false )
-		{
-			m_cells[r + 1][c].SetNumBombs(m_cells[r + 1][c].GetNumBombs() + 1);
-		}
+/***************************************************************
+*   Purpose: Gets a read-only view of every Cell, read straight
+*			 from the Board's memory.
+*
+*     Entry: None
+*
+*      Exit: Returns the view. It is empty for a chunked Board,
+*			 whose Cells are not in one block.
+****************************************************************/
+CellGrid Board::GetGrid() const
+{
+	if( m_chunked )
+		return CellGrid();
 
-		//bottom right
-		if( r < ( m_cells.getRow() - 1 ) && c < ( m_cells.getColumn() - 1 ) &&
-			m_cells[r + 1][c + 1].IsBomb() == false )
-		{
-			m_cells[r+1][c+1].SetNumBombs(m_cells[r+1][c+1].GetNumBombs() + 1);
-		}
-	}
-	catch( Exception Error )
-	{
-		cout << Error << endl;
-	}
+	return CellGrid( m_cells.data(), m_cells.getRow(), m_cells.getColumn(),
+					 m_cells.getColumn(), m_bombs );
 }
 
 /***************************************************************
-*   Purpose: This method will disperse the correct amount of bombs around
-*			 the board depending on the difficulty.
+*   Purpose: Increases the bomb count for the cells surrounding
+*			 this bomb.
 *            
-*     Entry: No bombs are on the board.
+*     Entry: The row and column of the bomb.
 *            
-*      Exit: Bombs will have been randomly dispersed across the board.
+*      Exit: All cells surrounding the bomb will have their bomb
+*			 count increased by one.
 ****************************************************************/
-void Board::PlaceBombs()
+void Board::SetNumber( int r, int c )
 {
-	srand( (int)time( NULL ) );
+	const int rows = m_cells.getRow();
+	const int cols = m_cells.getColumn();
 
-	int rand_num_r = 0;
-	int rand_num_c = 0;
-	int num = 0;
+	const int first_col = ( c > 0 ) ? c - 1 : c;
+	const int last_col = ( c < cols - 1 ) ? c + 1 : c;
+
+	m_regions.reset();
 
 	try
 	{
-		for( int i = 0; i < m_bombs; ++i )
+		if( r < 0 || r >= rows || c < 0 || c >= cols )
+			throw Exception( "ERROR: Cell out of bounds" );
+
+		for( int nr = ( r > 0 ) ? r - 1 : r; nr <= r + 1 && nr < rows; ++nr )
 		{
-			rand_num_r = rand() % m_cells.getRow();
-			rand_num_c = rand() % m_cells.getColumn();
+			Cell * row = m_cells.RowData( nr );
 
-			if( m_cells[rand_num_r][rand_num_c].IsBomb() == false )
+			for( int nc = first_col; nc <= last_col; ++nc )
 			{
-				m_cells[rand_num_r][rand_num_c].SetBomb();
-				SetNumber( rand_num_r, rand_num_c );
+				if( row[nc].IsBomb() == false )
+					row[nc].SetNumBombs( row[nc].GetNumBombs() + 1 );
 			}
-			else
-				i--;
 		}
 	}
 	catch( Exception Error )
@@ -202,185 +456,1590 @@ void Board::PlaceBombs()
 }
 
 /***************************************************************
-*   Purpose: This method will display the current Board according to flags
-*			 that are set in the Cell objects.
+*   Purpose: Recomputes the number of adjacent bombs for every Cell
+*			 on the Board in a single pass, instead of adding one to
+*			 the neighbours of each bomb in turn.
+*
+*			 The count is a 3x3 box sum over the bomb bits: each row
+*			 first has its bombs summed with the rows above and below
+*			 it, and then every three neighbouring column sums are
+*			 added together. Both steps work on 16 or 32 Cells at a
+*			 time when SSE2 or AVX2 is available.
 *            
-*     Entry: None.
+*     Entry: The bombs have been placed.
 *            
-*      Exit: Board is displayed to the console.
+*      Exit: Every Cell that is not a bomb holds the number of bombs
+*			 around it. Bomb Cells hold 0.
 ****************************************************************/
-int Board::DisplayBoard()
+void Board::SetNumbers()
 {
-	system( "cls" );
+	const int rows = m_cells.getRow();
+	const int cols = m_cells.getColumn();
 
-	HANDLE handle = 0;
-	const int DEFAULT = 7;
-	const int LIGHT_BLUE = 3;
-	int  num_covered = 0;
+	m_regions.reset();
 
-	handle = GetStdHandle( STD_OUTPUT_HANDLE );
+	if( rows == 0 || cols == 0 )
+		return;
 
-	cout << "   ";
+	// Column sums with a zero on each side so that the first and
+	// last columns can be summed like every other column
+	std::vector<unsigned char> sums( cols + 2, 0 );
+	std::vector<unsigned char> empty_row( cols, 0 );
 
-	for (int i = 0; i < m_cells.getColumn(); i++)
+	for( int r = 0; r < rows; ++r )
 	{
-		if( ( 65 + i ) < 91 )
-		{
-			SetConsoleTextAttribute( handle, LIGHT_BLUE );
-			cout << static_cast<char>( 65 + i ) << ' ';
-			SetConsoleTextAttribute( handle, DEFAULT );
-		}
-		else
-		{
-			SetConsoleTextAttribute( handle, LIGHT_BLUE );
-			cout << ( i - 25 ) << ' ';
-			SetConsoleTextAttribute( handle, DEFAULT );
-		}
+		unsigned char * row = reinterpret_cast<unsigned char *>( m_cells.RowData( r ) );
+		const unsigned char * above = empty_row.data();
+		const unsigned char * below = empty_row.data();
+
+		if( r > 0 )
+			above = reinterpret_cast<const unsigned char *>( m_cells.RowData( r - 1 ) );
+
+		if( r < rows - 1 )
+			below = reinterpret_cast<const unsigned char *>( m_cells.RowData( r + 1 ) );
+
+		SumBombColumns( above, row, below, sums.data() + 1, cols );
+		WriteBombCounts( sums.data() + 1, row, cols );
 	}
+}
+
+/***************************************************************
+*   Purpose: Adds up the bomb bits of three rows of Cells, column
+*			 by column.
+*
+*     Entry: The rows above, at and below the row being counted,
+*			 the array to store the sums in and the number of
+*			 columns.
+*
+*      Exit: sums[c] holds the number of bombs in column c of the
+*			 three rows (0 to 3).
+****************************************************************/
+void Board::SumBombColumns( const unsigned char * above,
+							const unsigned char * row,
+							const unsigned char * below,
+							unsigned char * sums, int cols )
+{
+	int c = 0;
 
-	cout << endl;
+#if defined( BOARD_USE_AVX2 )
+	const __m256i one32 = _mm256_set1_epi8( 1 );
 
-	for (int r = 0; r < m_cells.getRow(); r++)
+	for( ; c + 32 <= cols; c += 32 )
 	{
-		SetConsoleTextAttribute( handle, LIGHT_BLUE );
-		cout << '\n' << static_cast<char>( 65 + r ) << "  ";
-		SetConsoleTextAttribute( handle, DEFAULT );
+		__m256i a = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( above + c ) );
+		__m256i m = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( row + c ) );
+		__m256i b = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( below + c ) );
 
-		for( int c = 0; c < m_cells.getColumn(); c++ )
-		{
-			if( m_cells[r][c].Display() )
-				num_covered++;
-		}
+		a = _mm256_and_si256( _mm256_srli_epi16( a, 4 ), one32 );
+		m = _mm256_and_si256( _mm256_srli_epi16( m, 4 ), one32 );
+		b = _mm256_and_si256( _mm256_srli_epi16( b, 4 ), one32 );
+
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>( sums + c ),
+							 _mm256_add_epi8( _mm256_add_epi8( a, m ), b ) );
 	}
+#endif
 
-	cout << "\n\nNumber still covered: " << num_covered << endl;
+#if defined( BOARD_USE_SSE2 )
+	const __m128i one16 = _mm_set1_epi8( 1 );
 
-	return num_covered;
+	for( ; c + 16 <= cols; c += 16 )
+	{
+		__m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i *>( above + c ) );
+		__m128i m = _mm_loadu_si128( reinterpret_cast<const __m128i *>( row + c ) );
+		__m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i *>( below + c ) );
+
+		a = _mm_and_si128( _mm_srli_epi16( a, 4 ), one16 );
+		m = _mm_and_si128( _mm_srli_epi16( m, 4 ), one16 );
+		b = _mm_and_si128( _mm_srli_epi16( b, 4 ), one16 );
+
+		_mm_storeu_si128( reinterpret_cast<__m128i *>( sums + c ),
+						  _mm_add_epi8( _mm_add_epi8( a, m ), b ) );
+	}
+#endif
+
+	for( ; c < cols; ++c )
+	{
+		sums[c] = static_cast<unsigned char>( ( ( above[c] & Cell::BOMB_BIT ) >> 4 ) +
+											  ( ( row[c] & Cell::BOMB_BIT ) >> 4 ) +
+											  ( ( below[c] & Cell::BOMB_BIT ) >> 4 ) );
+	}
 }
 
 /***************************************************************
-*   Purpose: This method processes the users input as to which Cell they want
-*			 to modify (uncover or toggle flag) and sets the Cell's flags
-*			 accordingly.
-*            
-*     Entry: User's row and column information, as well as the
-*			 action they would like to take with that cell.
-*            
-*      Exit: Cell is uncovered or flagged.
+*   Purpose: Stores the number of adjacent bombs into a row of
+*			 Cells from the column sums of the row.
+*
+*     Entry: The column sums from SumBombColumns(), with a readable
+*			 zero at sums[-1] and sums[cols], the row of Cells and
+*			 the number of columns.
+*
+*      Exit: Each Cell's number is replaced with the sum of its
+*			 three column sums minus itself, or 0 if it is a bomb.
+*			 The other bits of the Cell are left alone.
 ****************************************************************/
-bool Board::ProcessCells( const char r, const char c, char action )
+void Board::WriteBombCounts( const unsigned char * sums, unsigned char * row, int cols )
 {
-	int row = 0;
-	int col = 0;
+	int c = 0;
 
-	row = ConvertCoords( toupper( r ) );
-	col = ConvertCoords( toupper( c ) );
+#if defined( BOARD_USE_AVX2 )
+	const __m256i one32 = _mm256_set1_epi8( 1 );
+	const __m256i state32 = _mm256_set1_epi8( static_cast<char>( ~Cell::NUM_BOMBS_MASK ) );
 
-	try
+	for( ; c + 32 <= cols; c += 32 )
 	{
-		if( toupper( action ) == 'U' )
-			CascadeCells( row, col );
-		else
-		{
-			if( m_cells[row][col].IsFlagged() )
-				m_cells[row][col].SetFlag( 'F' );
-			else
-				m_cells[row][col].SetFlag( 'T' );
-		}
+		__m256i cells = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( row + c ) );
+		__m256i left = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( sums + c - 1 ) );
+		__m256i middle = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( sums + c ) );
+		__m256i right = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( sums + c + 1 ) );
+		__m256i bomb = _mm256_and_si256( _mm256_srli_epi16( cells, 4 ), one32 );
+		__m256i count = _mm256_sub_epi8( _mm256_add_epi8( _mm256_add_epi8( left, middle ), right ), bomb );
+
+		// bomb - 1 is all ones for a safe Cell and all zeros for a bomb
+		count = _mm256_and_si256( count, _mm256_sub_epi8( bomb, one32 ) );
+		cells = _mm256_or_si256( _mm256_and_si256( cells, state32 ), count );
+
+		_mm256_storeu_si256( reinterpret_cast<__m256i *>( row + c ), cells );
 	}
-	catch( Exception Error )
+#endif
+
+#if defined( BOARD_USE_SSE2 )
+	const __m128i one16 = _mm_set1_epi8( 1 );
+	const __m128i state16 = _mm_set1_epi8( static_cast<char>( ~Cell::NUM_BOMBS_MASK ) );
+
+	for( ; c + 16 <= cols; c += 16 )
 	{
-		cout << Error << endl;
+		__m128i cells = _mm_loadu_si128( reinterpret_cast<const __m128i *>( row + c ) );
+		__m128i left = _mm_loadu_si128( reinterpret_cast<const __m128i *>( sums + c - 1 ) );
+		__m128i middle = _mm_loadu_si128( reinterpret_cast<const __m128i *>( sums + c ) );
+		__m128i right = _mm_loadu_si128( reinterpret_cast<const __m128i *>( sums + c + 1 ) );
+		__m128i bomb = _mm_and_si128( _mm_srli_epi16( cells, 4 ), one16 );
+		__m128i count = _mm_sub_epi8( _mm_add_epi8( _mm_add_epi8( left, middle ), right ), bomb );
+
+		// bomb - 1 is all ones for a safe Cell and all zeros for a bomb
+		count = _mm_and_si128( count, _mm_sub_epi8( bomb, one16 ) );
+		cells = _mm_or_si128( _mm_and_si128( cells, state16 ), count );
+
+		_mm_storeu_si128( reinterpret_cast<__m128i *>( row + c ), cells );
 	}
+#endif
 
-	if( IsLoss( m_cells[row][col] ) )
-		UncoverAllCells();
+	for( ; c < cols; ++c )
+	{
+		const int bomb = ( row[c] & Cell::BOMB_BIT ) >> 4;
+		int count = sums[c - 1] + sums[c] + sums[c + 1] - bomb;
+
+		if( bomb )
+			count = 0;
 
-	return IsLoss( m_cells[row][col] );
+		row[c] = static_cast<unsigned char>( ( row[c] & ~Cell::NUM_BOMBS_MASK ) | count );
+	}
 }
 
 /***************************************************************
-*   Purpose: This method converts the coordinate that is passed in from a char
-*			 to an int.
+*   Purpose: This method will disperse the correct amount of bombs around
+*			 the board depending on the difficulty.
 *            
-*     Entry: Character.
+*     Entry: No bombs are on the board.
 *            
-*      Exit: Integer.
+*      Exit: Bombs will have been randomly dispersed across the board.
+*			 GetSeed() returns the seed that reproduces this board.
 ****************************************************************/
-int Board::ConvertCoords( char x )
+void Board::PlaceBombs()
 {
-	int num = 0;
+	std::random_device device;
+	unsigned long long seed = device();
 
-	if( isalpha( x ) )
-		num = static_cast<int>( x ) - 65;
-	else
-		num = static_cast<int>( x ) - 23;
+	seed = ( seed << 32 ) ^ device();
+	seed ^= static_cast<unsigned long long>( time( NULL ) );
 
-	return num;
+	PlaceBombs( seed );
 }
 
 /***************************************************************
-*   Purpose: This method reveals all blank Cells around the selected cell if
-*			 the selected Cell is blank.
+*   Purpose: Same as PlaceBombs(), but the bombs are chosen by a
+*			 generator seeded with the value passed in, so the same
+*			 seed always gives the same board and separate threads
+*			 can place bombs on their own Boards at the same time.
+*
+*			 Uses Floyd's sampling algorithm with the board itself
+*			 as the set of chosen cells: exactly m_bombs random
+*			 numbers are drawn whatever the density, and there is
+*			 never a retry on a collision. The numbers are filled in
+*			 afterwards by a single SetNumbers() pass.
 *            
-*     Entry: Cells are covered.
+*     Entry: No bombs are on the board. The seed for the generator.
 *            
-*      Exit: All adjacent blank cells are uncovered.
+*      Exit: Bombs will have been randomly dispersed across the board.
 ****************************************************************/
-void Board::CascadeCells( int row, int col )
+void Board::PlaceBombs( unsigned long long seed )
 {
-	if( m_cells[row][col].IsCovered() )
-	{
-		if( m_cells[row][col].GetNumBombs() > 0 )
-			m_cells[row][col].Uncover();
-		else if( m_cells[row][col].GetNumBombs() == 0 )
-		{
-			m_cells[row][col].Uncover();
+	PlaceBombsAvoiding( seed, -1, -1 );
+}
 
-			if( row > 0 ) // top middle
-				CascadeCells( row - 1, col );
-		
-			if( row > 0 && col < ( m_cells.getColumn() - 1 ) ) // top right
-				CascadeCells( row - 1, col + 1 );
+/***************************************************************
+*   Purpose: Same as PlaceBombs( seed ), but no bomb is put on the
+*			 given Cell or the eight Cells around it, so that the
+*			 first click there always opens an area.
+*            
+*     Entry: No bombs are on the board. The seed for the generator
+*			 and the row and column of the first click.
+*            
+*      Exit: Bombs will have been randomly dispersed across the
+*			 rest of the board.
+****************************************************************/
+void Board::PlaceBombs( unsigned long long seed, int safe_row, int safe_col )
+{
+	PlaceBombsAvoiding( seed, safe_row, safe_col );
+}
+
+/***************************************************************
+*   Purpose: Does the work of both seeded PlaceBombs() methods.
+*			 The Cells left free are numbered in row order with the
+*			 kept-clear Cells skipped, and Floyd's sampling picks
+*			 from those numbers. With nothing kept clear this gives
+*			 exactly the same board as before for the same seed.
+*            
+*			 A chunked Board only remembers the seed and the Cell
+*			 to keep clear; each tile places its own bombs when it
+*			 is made.
+*            
+*     Entry: The seed and the Cell whose 3x3 block is kept clear,
+*			 or -1 for the row to keep nothing clear.
+*            
+*      Exit: Bombs are placed and the numbers are set.
+****************************************************************/
+void Board::PlaceBombsAvoiding( unsigned long long seed, int safe_row, int safe_col )
+{
+	const int rows = m_cells.getRow();
+	const int cols = m_cells.getColumn();
+	Cell * cells = m_cells.data();
+	Random generator( seed );
+	int clear[9];
+	int num_clear = 0;
+	int chosen = 0;
+
+	m_seed = seed;
+	m_safe_row = safe_row;
+	m_safe_col = safe_col;
 
-			if( col < ( m_cells.getColumn() ) - 1 ) // right
-				CascadeCells( row, col + 1 );
+	if( m_chunked )
+		return;
+
+	if( safe_row >= 0 )
+	{
+		for( int r = safe_row - 1; r <= safe_row + 1; ++r )
+			for( int c = safe_col - 1; c <= safe_col + 1; ++c )
+				if( r >= 0 && r < rows && c >= 0 && c < cols )
+					clear[num_clear++] = ( r * cols ) + c;
+	}
 
-			if( row < ( m_cells.getRow() - 1 ) && col < ( m_cells.getColumn() - 1 ) ) // bottom right
-				CascadeCells( row + 1, col + 1 );
+	const int num_cells = ( rows * cols ) - num_clear;
 
-			if( row < ( m_cells.getRow() - 1 ) ) // bottom middle
-				CascadeCells( row + 1, col );
+	try
+	{
+		if( m_bombs < 0 || m_bombs > num_cells )
+			throw Exception( "ERROR: More bombs than cells on the board" );
 
-			if( row < ( m_cells.getRow() - 1 ) && col > 0 ) // bottom left
-				CascadeCells( row + 1, col - 1 );
+		for( int i = num_cells - m_bombs; i < num_cells; ++i )
+		{
+			chosen = static_cast<int>( generator.NextBelow( i + 1 ) );
 
-			if( col > 0 ) // left
-				CascadeCells( row, col - 1 );
+			if( cells[SkipClearCells( chosen, clear, num_clear )].IsBomb() )
+				chosen = i;
 
-			if( col > 0 && row > 0 ) // top left
-				CascadeCells( row - 1, col - 1 );
+			cells[SkipClearCells( chosen, clear, num_clear )].SetBomb();
 		}
+
+		SetNumbers();
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
 	}
 }
 
 /***************************************************************
-*   Purpose: Uncovers every cell on the board, reguardless of
-*			 cell status.
-*
-*     Entry: Cells are covered.
-*
-*      Exit: All cells are uncovered.
+*   Purpose: Turns the number of a free Cell into its index on the
+*			 Board by stepping over the kept-clear Cells before it.
+*            
+*     Entry: The number of the free Cell and the kept-clear Cells
+*			 in increasing order.
+*            
+*      Exit: Returns the index on the Board.
 ****************************************************************/
-void Board::UncoverAllCells()
+int Board::SkipClearCells( int index, const int * clear, int num_clear )
 {
-	for (int i = 0; i < m_cells.getRow(); i++)
+	for( int i = 0; i < num_clear; ++i )
 	{
-		for (int j = 0; j < m_cells.getColumn(); j++)
-		{
-			m_cells[i][j].Uncover();
-		}
+		if( clear[i] <= index )
+			index++;
 	}
+
+	return index;
+}
+
+/***************************************************************
+*   Purpose: Labels the blank regions of the Board with
+*			 ZeroRegions, so that the cascade from a blank Cell is
+*			 read from a list rather than searched for. Copies of
+*			 the Board share the labels.
+*
+*     Entry: The bombs are placed.
+*
+*      Exit: The regions are labelled, unless the Board is
+*			 chunked.
+****************************************************************/
+void Board::LabelRegions()
+{
+	m_regions.reset();
+
+	if( m_chunked )
+		return;
+
+	std::shared_ptr<ZeroRegions> regions = std::make_shared<ZeroRegions>();
+
+	regions->Label( m_cells.data(), m_cells.getRow(), m_cells.getColumn() );
+	m_regions = regions;
+}
+
+/***************************************************************
+*   Purpose: This method returns true if the blank regions of the
+*			 Board are labelled.
+****************************************************************/
+bool Board::HasRegions() const
+{
+	return m_regions != nullptr;
+}
+
+/***************************************************************
+*   Purpose: This method returns the seed that the bombs on the
+*			 Board were placed with.
+****************************************************************/
+unsigned long long Board::GetSeed() const
+{
+	return m_seed;
+}
+
+/***************************************************************
+*   Purpose: Gets the Cell whose 3x3 block PlaceBombs() kept free
+*			 of bombs.
+*
+*     Entry: Where to store the row and column.
+*
+*      Exit: Returns false, storing -1, if nothing was kept clear.
+****************************************************************/
+bool Board::GetSafeCell( int & row, int & col ) const
+{
+	row = m_safe_row;
+	col = m_safe_col;
+
+	return m_safe_row >= 0;
+}
+
+/***************************************************************
+*   Purpose: Returns a checksum (32 bit FNV-1a) of the state of
+*			 every Cell, so that a replayed game can be checked
+*			 against the one that was recorded without keeping a
+*			 copy of the Board. A chunked Board sums its stored
+*			 tiles in the order they were made.
+*
+*     Entry: None
+*
+*      Exit: Returns the checksum.
+****************************************************************/
+unsigned int Board::GetChecksum() const
+{
+	const unsigned char * bytes = reinterpret_cast<const unsigned char *>( m_cells.data() );
+	const int length = m_cells.getRow() * m_cells.getColumn();
+	unsigned int hash = 2166136261u;
+
+	for( int i = 0; i < length; ++i )
+		hash = ( hash ^ bytes[i] ) * 16777619u;
+
+	for( int i = 0; i < m_tiles.getNumTiles(); ++i )
+	{
+		bytes = reinterpret_cast<const unsigned char *>( m_tiles.TileData( i ) );
+
+		for( int j = 0; j < ChunkedArray2D<Cell>::TILE_CELLS; ++j )
+			hash = ( hash ^ bytes[j] ) * 16777619u;
+	}
+
+	return hash;
+}
+
+/***************************************************************
+*   Purpose: Makes ProcessCell() record every action it is given
+*			 in a Journal, so that the game can be replayed. The
+*			 Board does not own the Journal, and a copy of the
+*			 Board does not record into it.
+*
+*     Entry: The Journal, or nullptr to stop recording.
+*
+*      Exit: None
+****************************************************************/
+void Board::SetJournal( Journal * journal )
+{
+	m_journal = journal;
+}
+
+/***************************************************************
+*   Purpose: This method will display the current Board according to flags
+*			 that are set in the Cell objects.
+*            
+*     Entry: None.
+*            
+*      Exit: Board is displayed to the console, in one write on a
+*			 POSIX terminal. A chunked Board is too big to draw
+*			 whole; it is reported and not drawn, and the number of
+*			 covered Cells in its stored tiles is returned.
+****************************************************************/
+int Board::DisplayBoard()
+{
+	Terminal terminal;
+	int  num_covered = 0;
+
+	try
+	{
+		if( m_chunked )
+			throw Exception( "ERROR: A chunked board can only be drawn by the Viewport" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return m_num_covered;
+	}
+
+	terminal.Clear();
+	terminal.SetColor( Terminal::DEFAULT );
+	terminal.Print( "   " );
+	terminal.SetColor( Terminal::LIGHT_BLUE );
+
+	for (int i = 0; i < m_cells.getColumn(); i++)
+	{
+		if( ( 65 + i ) < 91 )
+			terminal.Print( static_cast<char>( 65 + i ) );
+		else
+			terminal.Print( i - 25 );
+
+		terminal.Print( ' ' );
+	}
+
+	terminal.Print( '\n' );
+
+	for (int r = 0; r < m_cells.getRow(); r++)
+	{
+		terminal.SetColor( Terminal::LIGHT_BLUE );
+		terminal.Print( '\n' );
+		terminal.Print( static_cast<char>( 65 + r ) );
+		terminal.Print( "  " );
+
+		Cell * row = m_cells.RowData( r );
+
+		for( int c = 0; c < m_cells.getColumn(); c++ )
+		{
+			if( row[c].Display( terminal ) )
+				num_covered++;
+		}
+	}
+
+	terminal.SetColor( Terminal::DEFAULT );
+	terminal.Print( "\n\nNumber still covered: " );
+	terminal.Print( num_covered );
+	terminal.Print( '\n' );
+	terminal.Flush();
+
+	return num_covered;
+}
+
+/***************************************************************
+*   Purpose: This method processes the users input as to which Cell they want
+*			 to modify (uncover or toggle flag) and sets the Cell's flags
+*			 accordingly.
+*            
+*     Entry: User's row and column information, as well as the
+*			 action they would like to take with that cell.
+*            
+*      Exit: Cell is uncovered or flagged.
+****************************************************************/
+bool Board::ProcessCells( const char r, const char c, char action )
+{
+	int row = 0;
+	int col = 0;
+
+	row = ConvertCoords( toupper( r ) );
+	col = ConvertCoords( toupper( c ) );
+
+	return ProcessCell( row, col, action );
+}
+
+/***************************************************************
+*   Purpose: Same as ProcessCells(), but takes the row and column
+*			 as numbers instead of the characters typed in by the
+*			 user.
+*            
+*     Entry: The row and column of the Cell, as well as the action
+*			 to take with that cell.
+*            
+*      Exit: Cell is uncovered, flagged or chorded. Returns true
+*			 if a bomb was uncovered. A Cell that is not on the
+*			 Board is reported and ignored, and is not recorded.
+*			 Any other action is recorded in the Journal before it
+*			 is carried out, if there is one.
+****************************************************************/
+bool Board::ProcessCell( int row, int col, char action )
+{
+	bool lost = false;
+
+	try
+	{
+		if( row < 0 || row >= GetRows() || col < 0 || col >= GetCols() )
+			throw Exception( "ERROR: Cell out of bounds" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	if( m_journal != nullptr )
+		m_journal->Record( *this, row, col, action );
+
+	lost = ApplyAction( row, col, action );
+	DrainCascade();
+
+	if( lost )
+		UncoverAllCells();
+
+	return lost;
+}
+
+/***************************************************************
+*   Purpose: Carries out a list of actions in one call. Each
+*			 action uncovers, flags or chords its Cell straight
+*			 away, but the cascades they start are only spread once
+*			 every action has been carried out, in a single pass.
+*			 The only exception is a chord, which needs its
+*			 neighbours to be up to date, so any cascade still
+*			 waiting is spread just before it. The Board ends up
+*			 exactly as if the actions had been passed to
+*			 ProcessCell() one at a time.
+*            
+*     Entry: The actions, in order, and the list to store the
+*			 changed Cells in.
+*            
+*      Exit: changed holds the index, ( row * columns ) + column,
+*			 of every Cell that was uncovered or had its flag
+*			 toggled. Returns true if a bomb was uncovered; the
+*			 actions after it are not carried out and every Cell
+*			 is uncovered. An action on a Cell that is not on the
+*			 Board is reported and skipped. Each action carried
+*			 out is recorded in the Journal, if there is one. A
+*			 chunked Board does not track changes, so changed is
+*			 left empty.
+****************************************************************/
+bool Board::ProcessActions( const std::vector<BoardAction> & actions, std::vector<int> & changed )
+{
+	const bool track = m_track_changes;
+	const size_t first = m_changes.size();
+	bool lost = false;
+
+	m_track_changes = ( m_chunked == false );
+	m_cascade.clear();
+
+	for( const BoardAction & action : actions )
+	{
+		try
+		{
+			if( action.row < 0 || action.row >= GetRows() ||
+				action.col < 0 || action.col >= GetCols() )
+				throw Exception( "ERROR: Cell out of bounds" );
+		}
+		catch( Exception Error )
+		{
+			cout << Error << endl;
+			continue;
+		}
+
+		if( m_journal != nullptr )
+			m_journal->Record( *this, action.row, action.col, action.action );
+
+		if( toupper( action.action ) == 'C' )
+			DrainCascade();
+
+		if( ApplyAction( action.row, action.col, action.action ) )
+		{
+			lost = true;
+			break;
+		}
+	}
+
+	DrainCascade();
+
+	changed.assign( m_changes.begin() + first, m_changes.end() );
+
+	if( track == false )
+		m_changes.resize( first );
+
+	m_track_changes = track;
+
+	if( lost )
+		UncoverAllCells();
+
+	return lost;
+}
+
+/***************************************************************
+*   Purpose: Carries out one action without spreading the
+*			 cascade it starts. See DrainCascade().
+*            
+*     Entry: A Cell on the Board and the action, 'U' to uncover
+*			 it, 'C' to chord it or anything else to toggle its
+*			 flag.
+*            
+*      Exit: Returns true if a bomb was uncovered.
+****************************************************************/
+bool Board::ApplyAction( int row, int col, char action )
+{
+	const char upper = static_cast<char>( toupper( action ) );
+
+	if( upper == 'U' )
+	{
+		RevealSeed( row, col );
+
+		return IsLoss( At( row, col ) );
+	}
+
+	if( upper == 'C' )
+		return ChordCell( row, col );
+
+	Cell & cell = At( row, col );
+
+	if( cell.IsFlagged() )
+	{
+		cell.SetFlag( 'F' );
+
+		if( cell.IsCovered() )
+			m_num_flags--;
+	}
+	else
+	{
+		cell.SetFlag( 'T' );
+
+		if( cell.IsCovered() )
+			m_num_flags++;
+	}
+
+	// Only a plain Board, whose Cells can be counted in an int, tracks changes
+	if( m_track_changes )
+		m_changes.push_back( ( row * GetCols() ) + col );
+
+	return IsLoss( cell );
+}
+
+/***************************************************************
+*   Purpose: Chords a Cell: if it is an uncovered number and as
+*			 many of its neighbours are flagged, every other
+*			 covered neighbour is uncovered.
+*            
+*     Entry: A Cell on the Board.
+*            
+*      Exit: The neighbours are uncovered, with their cascades
+*			 waiting for DrainCascade(). Returns true if one of
+*			 them was a bomb, which means a flag was wrong.
+****************************************************************/
+bool Board::ChordCell( int row, int col )
+{
+	const int rows = GetRows();
+	const int cols = GetCols();
+	const Cell & centre = At( row, col );
+	const int number = centre.GetNumBombs();
+	int flags = 0;
+	bool lost = false;
+
+	if( centre.IsCovered() || centre.IsBomb() || number == 0 )
+		return false;
+
+	for( int r = row - 1; r <= row + 1; ++r )
+		for( int c = col - 1; c <= col + 1; ++c )
+			if( r >= 0 && r < rows && c >= 0 && c < cols && At( r, c ).IsCovered() &&
+				At( r, c ).IsFlagged() )
+				flags++;
+
+	if( flags != number )
+		return false;
+
+	for( int r = row - 1; r <= row + 1; ++r )
+	{
+		for( int c = col - 1; c <= col + 1; ++c )
+		{
+			if( r < 0 || r >= rows || c < 0 || c >= cols )
+				continue;
+
+			const Cell & cell = At( r, c );
+
+			if( cell.IsCovered() && cell.IsFlagged() == false )
+			{
+				lost = lost || cell.IsBomb();
+				RevealSeed( r, c );
+			}
+		}
+	}
+
+	return lost;
+}
+
+/***************************************************************
+*   Purpose: This method converts the coordinate that is passed in from a char
+*			 to an int.
+*            
+*     Entry: Character.
+*            
+*      Exit: Integer.
+****************************************************************/
+int Board::ConvertCoords( char x )
+{
+	int num = 0;
+
+	if( isalpha( x ) )
+		num = static_cast<int>( x ) - 65;
+	else
+		num = static_cast<int>( x ) - 23;
+
+	return num;
+}
+
+/***************************************************************
+*   Purpose: This method reveals all blank Cells around the selected cell if
+*			 the selected Cell is blank.
+*
+*			 The Cell is uncovered by RevealSeed() and the flood
+*			 fill is done by DrainCascade(). Chunked Boards are
+*			 handed to CascadeTiles().
+*            
+*     Entry: Cells are covered.
+*            
+*      Exit: All adjacent blank cells are uncovered. Returns the
+*			 number of Cells that were uncovered.
+****************************************************************/
+int Board::CascadeCells( int row, int col )
+{
+	if( m_chunked )
+		return CascadeTiles( row, col );
+
+	if( m_cells[row][col].IsCovered() == false )
+		return 0;
+
+	const int covered = m_num_covered;
+
+	m_cascade.clear();
+	RevealSeed( row, col );
+	DrainCascade();
+
+	return covered - m_num_covered;
+}
+
+/***************************************************************
+*   Purpose: Uncovers one Cell and, if it is blank, leaves it on
+*			 the work stack for DrainCascade() to spread from, so
+*			 that several Cells can be uncovered before a single
+*			 flood fill. A chunked Board cascades straight away.
+*
+*			 If LabelRegions() has been called, the blank Cell's
+*			 whole region is uncovered from its list instead. That
+*			 gives the same Cells as the flood fill, since a blank
+*			 Cell is only ever uncovered along with its region.
+*            
+*     Entry: A Cell on the Board.
+*            
+*      Exit: The Cell is uncovered, if it was covered.
+****************************************************************/
+void Board::RevealSeed( int row, int col )
+{
+	if( m_chunked )
+	{
+		CascadeTiles( row, col );
+		return;
+	}
+
+	const int index = ( row * m_cells.getColumn() ) + col;
+	Cell & cell = m_cells.data()[index];
+
+	if( cell.IsCovered() == false )
+		return;
+
+	RevealCell( cell, index );
+
+	if( cell.IsBomb() || cell.GetNumBombs() != 0 )
+		return;
+
+	if( m_regions == nullptr )
+	{
+		m_cascade.push_back( index );
+		return;
+	}
+
+	// Every Cell the cascade would reach is already listed
+	Cell * cells = m_cells.data();
+	int count = 0;
+	const int * region = m_regions->GetCells( m_regions->GetRegion( index ), count );
+
+	for( int i = 0; i < count; ++i )
+		if( cells[region[i]].IsCovered() )
+			RevealCell( cells[region[i]], region[i] );
+}
+
+/***************************************************************
+*   Purpose: Spreads the cascades of every blank Cell left on the
+*			 work stack by RevealSeed().
+*
+*			 The flood fill is iterative: every Cell is uncovered at
+*			 the moment it is pushed onto the work stack, so each Cell
+*			 is visited at most once and the stack depth never depends
+*			 on the shape of the blank region.
+*
+*			 A cascade that is still going after uncovering
+*			 PARALLEL_CASCADE_CELLS Cells is opening a very big area,
+*			 so unless SetCascadeThreads( 1 ) was called, what is
+*			 left on the stack is handed to SpreadInParallel(). The
+*			 Cells uncovered are the same either way.
+*            
+*     Entry: None
+*            
+*      Exit: All blank cells connected to the ones on the stack
+*			 and their neighbours are uncovered. The stack is empty.
+****************************************************************/
+void Board::DrainCascade()
+{
+	if( m_chunked )
+		return;
+
+	const int rows = m_cells.getRow();
+	const int cols = m_cells.getColumn();
+	const int covered = m_num_covered;
+	Cell * cells = m_cells.data();
+
+	while( m_cascade.empty() == false )
+	{
+		if( m_cascade_threads != 1 && covered - m_num_covered > PARALLEL_CASCADE_CELLS &&
+			SpreadInParallel() )
+			return;
+
+		const int index = m_cascade.back();
+		const int r = index / cols;
+		const int c = index % cols;
+
+		m_cascade.pop_back();
+
+		for( int nr = r - 1; nr <= r + 1; ++nr )
+		{
+			if( nr < 0 || nr >= rows )
+				continue;
+
+			for( int nc = c - 1; nc <= c + 1; ++nc )
+			{
+				if( nc < 0 || nc >= cols )
+					continue;
+
+				Cell & cell = cells[( nr * cols ) + nc];
+
+				if( cell.IsCovered() )
+				{
+					RevealCell( cell, ( nr * cols ) + nc );
+
+					if( cell.GetNumBombs() == 0 )
+						m_cascade.push_back( ( nr * cols ) + nc );
+				}
+			}
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: Finishes a cascade on several threads with a
+*			 ParallelCascade, starting from the blank Cells left on
+*			 the work stack, and adds what it did to the counters.
+*            
+*     Entry: The Board is not chunked.
+*            
+*      Exit: Returns false, doing nothing, if there is only one
+*			 thread to use. Otherwise the cascade is finished and
+*			 the stack is empty. The changed Cells, if tracked, are
+*			 not in the order the single threaded cascade would
+*			 give.
+****************************************************************/
+bool Board::SpreadInParallel()
+{
+	int threads = m_cascade_threads;
+
+	if( threads <= 0 )
+		threads = static_cast<int>( std::thread::hardware_concurrency() );
+
+	if( threads <= 1 )
+	{
+		// Not asked again for the rest of this cascade
+		m_cascade_threads = 1;
+		return false;
+	}
+
+	ParallelCascade cascade( m_cells.data(), m_cells.getRow(), m_cells.getColumn() );
+
+	cascade.Run( m_cascade, threads, m_track_changes );
+	m_cascade.clear();
+
+	m_num_covered -= static_cast<int>( cascade.GetUncovered() );
+	m_num_flags -= static_cast<int>( cascade.GetUnflagged() );
+	m_num_revealed += static_cast<int>( cascade.GetRevealed() );
+	m_lost = m_lost || cascade.IsLost();
+
+	if( m_track_changes )
+		m_changes.insert( m_changes.end(), cascade.GetChanges().begin(), cascade.GetChanges().end() );
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Sets how many threads a cascade that opens a very
+*			 big area is spread across.
+*            
+*     Entry: The number of threads. 0 means one per core and 1
+*			 keeps every cascade on the calling thread.
+*            
+*      Exit: None
+****************************************************************/
+void Board::SetCascadeThreads( int threads )
+{
+	m_cascade_threads = threads;
+}
+
+/***************************************************************
+*   Purpose: Same as CascadeCells(), for a chunked Board. The work
+*			 stack holds a row and a column for each Cell instead
+*			 of an index, since the Board can be too big for an int
+*			 index, and the tiles the fill runs into are made as it
+*			 goes. A chunked Board does not track changes, so no
+*			 index is worked out for the Cells it uncovers.
+*            
+*     Entry: Cells are covered.
+*            
+*      Exit: All adjacent blank cells are uncovered. Returns the
+*			 number of Cells that were uncovered.
+****************************************************************/
+int Board::CascadeTiles( int row, int col )
+{
+	const int rows = m_tiles.getRow();
+	const int cols = m_tiles.getColumn();
+	int revealed = 0;
+
+	assert( m_track_changes == false );
+
+	if( row < 0 || row >= rows || col < 0 || col >= cols )
+		throw Exception( "ERROR: Cell out of bounds" );
+
+	Cell & start = At( row, col );
+
+	if( start.IsCovered() == false )
+		return 0;
+
+	RevealCell( start, -1 );
+	revealed++;
+
+	if( start.IsBomb() || start.GetNumBombs() > 0 )
+		return revealed;
+
+	m_cascade.clear();
+	m_cascade.push_back( row );
+	m_cascade.push_back( col );
+
+	while( m_cascade.empty() == false )
+	{
+		const int c = m_cascade.back();
+		m_cascade.pop_back();
+		const int r = m_cascade.back();
+		m_cascade.pop_back();
+
+		for( int nr = r - 1; nr <= r + 1; ++nr )
+		{
+			if( nr < 0 || nr >= rows )
+				continue;
+
+			for( int nc = c - 1; nc <= c + 1; ++nc )
+			{
+				if( nc < 0 || nc >= cols )
+					continue;
+
+				Cell & cell = At( nr, nc );
+
+				if( cell.IsCovered() )
+				{
+					RevealCell( cell, -1 );
+					revealed++;
+
+					if( cell.GetNumBombs() == 0 )
+					{
+						m_cascade.push_back( nr );
+						m_cascade.push_back( nc );
+					}
+				}
+			}
+		}
+	}
+
+	return revealed;
+}
+
+/***************************************************************
+*   Purpose: Uncovers every cell on the board, reguardless of
+*			 cell status. This only shows the board; it does not
+*			 change whether the game counts as won or lost. On a
+*			 chunked Board only the stored tiles are uncovered.
+*
+*     Entry: Cells are covered.
+*
+*      Exit: All cells are uncovered.
+****************************************************************/
+void Board::UncoverAllCells()
+{
+	for( Cell & cell : m_cells )
+		cell.Uncover();
+
+	for( int i = 0; i < m_tiles.getNumTiles(); ++i )
+	{
+		Cell * tile = m_tiles.TileData( i );
+
+		for( int j = 0; j < ChunkedArray2D<Cell>::TILE_CELLS; ++j )
+			tile[j].Uncover();
+	}
+
+	m_num_covered = 0;
+	m_num_flags = 0;
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Returns the number of Cells that are still covered
+*			 (flagged Cells count as covered) without displaying
+*			 the Board.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of covered Cells.
+****************************************************************/
+int Board::GetNumCovered() const
+{
+	return m_num_covered;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of covered Cells that are flagged.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of flags.
+****************************************************************/
+int Board::GetNumFlags() const
+{
+	return m_num_flags;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of Cells without a bomb that have
+*			 been uncovered.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of revealed safe Cells.
+****************************************************************/
+int Board::GetNumRevealed() const
+{
+	return m_num_revealed;
+}
+
+/***************************************************************
+*   Purpose: Tells whether the game on this Board has been won,
+*			 which is when every Cell without a bomb has been
+*			 uncovered and no bomb has been. A chunked Board is
+*			 only won once every tile has been made and the only
+*			 covered Cells left are bombs.
+*
+*     Entry: None
+*
+*      Exit: Returns true if the game is won.
+****************************************************************/
+bool Board::IsWon() const
+{
+	if( m_chunked )
+	{
+		return m_lost == false && m_num_covered == m_loaded_bombs &&
+			   m_tiles.getNumTiles() == static_cast<long long>( m_tiles.getTileRows() ) *
+										m_tiles.getTileColumns();
+	}
+
+	return m_lost == false &&
+		   m_num_revealed == ( m_cells.getRow() * m_cells.getColumn() ) - m_bombs;
+}
+
+/***************************************************************
+*   Purpose: Tells whether a bomb has been uncovered by the player.
+*
+*     Entry: None
+*
+*      Exit: Returns true if the game is lost.
+****************************************************************/
+bool Board::IsLost() const
+{
+	return m_lost;
+}
+
+/***************************************************************
+*   Purpose: Turns the recording of changed Cells on or off. It
+*			 is off by default, so that play that nobody is
+*			 watching does not pay for it.
+*
+*     Entry: True to record changes.
+*
+*      Exit: The list of changed Cells is emptied. A chunked Board
+*			 can be too big for its Cells to be counted in an int,
+*			 so asking it to record changes is reported and
+*			 ignored.
+****************************************************************/
+void Board::TrackChanges( bool track )
+{
+	try
+	{
+		if( track && m_chunked )
+			throw Exception( "ERROR: A chunked board does not track changes" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		track = false;
+	}
+
+	m_track_changes = track;
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Returns the Cells that were uncovered or had their
+*			 flag toggled since the list was last cleared, as
+*			 ( row * columns ) + column, in the order it happened.
+*			 UncoverAllCells() ends the game and empties the list.
+*
+*     Entry: None
+*
+*      Exit: Returns the list by constant reference.
+****************************************************************/
+const std::vector<int> & Board::GetChangedCells() const
+{
+	return m_changes;
+}
+
+/***************************************************************
+*   Purpose: Empties the list of changed Cells once they have
+*			 been dealt with.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void Board::ClearChangedCells()
+{
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Uncovers one covered Cell and updates the counters.
+*
+*     Entry: A covered Cell of this Board and its index,
+*			 ( row * columns ) + column. A chunked Board, which does
+*			 not track changes, passes -1.
+*
+*      Exit: The Cell is uncovered and recorded as changed if
+*			 changes are being tracked. Uncovering a bomb loses the
+*			 game.
+****************************************************************/
+void Board::RevealCell( Cell & cell, int index )
+{
+	if( cell.IsFlagged() )
+		m_num_flags--;
+
+	cell.Uncover();
+	m_num_covered--;
+
+	if( cell.IsBomb() )
+		m_lost = true;
+	else
+		m_num_revealed++;
+
+	if( m_track_changes )
+		m_changes.push_back( index );
+}
+
+/***************************************************************
+*   Purpose: Counts the covered, flagged and revealed Cells again
+*			 by walking the whole Board. Only needed after the size
+*			 of the Board has been changed.
+*
+*     Entry: None
+*
+*      Exit: The counters match the Cells.
+****************************************************************/
+void Board::RecountCells()
+{
+	m_num_covered = 0;
+	m_num_flags = 0;
+	m_num_revealed = 0;
+	m_lost = false;
+
+	for( const Cell & cell : m_cells )
+	{
+		if( cell.IsCovered() )
+		{
+			m_num_covered++;
+
+			if( cell.IsFlagged() )
+				m_num_flags++;
+		}
+		else if( cell.IsBomb() )
+			m_lost = true;
+		else
+			m_num_revealed++;
+	}
+}
+
+/***************************************************************
+*   Purpose: Gets a Cell to change. On a chunked Board the tile
+*			 holding it is made first if it is not stored yet.
+*
+*     Entry: The row and column of a Cell on the Board.
+*
+*      Exit: Returns the Cell.
+****************************************************************/
+Cell & Board::At( int row, int col )
+{
+	if( m_chunked )
+	{
+		Cell * tile = LoadTile( row / TILE_SIZE, col / TILE_SIZE );
+
+		return tile[( ( row % TILE_SIZE ) * TILE_SIZE ) + ( col % TILE_SIZE )];
+	}
+
+	return m_cells.SelectUnchecked( row, col );
+}
+
+/***************************************************************
+*   Purpose: Gets a tile of a chunked Board, making it the first
+*			 time. A new tile gets its bombs from TileBombs(), and
+*			 its numbers from the bombs of its own layout and those
+*			 of the eight tiles around it, which are worked out
+*			 again from the seed rather than stored.
+*
+*     Entry: The row and column of the tile.
+*
+*      Exit: Returns the tile. The counters include it.
+****************************************************************/
+Cell * Board::LoadTile( int tile_row, int tile_col )
+{
+	Cell * tile = m_tiles.FindTile( tile_row, tile_col );
+
+	if( tile != nullptr )
+		return tile;
+
+	// Bomb layout of the 3x3 block of tiles, one bit per column
+	unsigned long long masks[3][3][TILE_SIZE] = {};
+
+	for( int dr = 0; dr < 3; ++dr )
+	{
+		for( int dc = 0; dc < 3; ++dc )
+		{
+			const int r = tile_row + dr - 1;
+			const int c = tile_col + dc - 1;
+
+			if( r >= 0 && r < m_tiles.getTileRows() && c >= 0 && c < m_tiles.getTileColumns() )
+				TileBombs( r, c, masks[dr][dc] );
+		}
+	}
+
+	const int rows = std::min( TILE_SIZE, m_tiles.getRow() - ( tile_row * TILE_SIZE ) );
+	const int cols = std::min( TILE_SIZE, m_tiles.getColumn() - ( tile_col * TILE_SIZE ) );
+
+	tile = m_tiles.AddTile( tile_row, tile_col );
+
+	for( int r = 0; r < rows; ++r )
+	{
+		for( int c = 0; c < cols; ++c )
+		{
+			Cell & cell = tile[( r * TILE_SIZE ) + c];
+			int count = 0;
+
+			if( ( masks[1][1][r] >> c ) & 1 )
+			{
+				cell.SetBomb();
+				m_loaded_bombs++;
+				continue;
+			}
+
+			for( int nr = r - 1; nr <= r + 1; ++nr )
+			{
+				// Which tile of the block the neighbour is in, and where
+				const int dr = ( nr < 0 ) ? 0 : ( ( nr >= TILE_SIZE ) ? 2 : 1 );
+				const int lr = ( nr + TILE_SIZE ) % TILE_SIZE;
+
+				for( int nc = c - 1; nc <= c + 1; ++nc )
+				{
+					const int dc = ( nc < 0 ) ? 0 : ( ( nc >= TILE_SIZE ) ? 2 : 1 );
+					const int lc = ( nc + TILE_SIZE ) % TILE_SIZE;
+
+					count += static_cast<int>( ( masks[dr][dc][lr] >> lc ) & 1 );
+				}
+			}
+
+			cell.SetNumBombs( count );
+		}
+	}
+
+	m_num_covered += rows * cols;
+
+	return tile;
+}
+
+/***************************************************************
+*   Purpose: Lays out the bombs of a tile of a chunked Board with
+*			 Floyd's sampling, like PlaceBombs() does for a whole
+*			 Board, from a generator seeded by the Board's seed and
+*			 the tile's position. The same tile always gets the
+*			 same bombs, whether or not it has been stored.
+*
+*     Entry: The row and column of the tile and the TILE_SIZE
+*			 words to set the bits in, which are all zero.
+*
+*      Exit: Bit c of mask[r] is set if the Cell at row r, column
+*			 c of the tile is a bomb.
+****************************************************************/
+void Board::TileBombs( int tile_row, int tile_col, unsigned long long * mask ) const
+{
+	const int first_row = tile_row * TILE_SIZE;
+	const int first_col = tile_col * TILE_SIZE;
+	const int rows = std::min( TILE_SIZE, m_tiles.getRow() - first_row );
+	const int cols = std::min( TILE_SIZE, m_tiles.getColumn() - first_col );
+	Random generator( m_seed ^ ( static_cast<unsigned long long>( tile_row ) * 0x9E3779B97F4A7C15ULL ) ^
+					  ( static_cast<unsigned long long>( tile_col ) * 0xC2B2AE3D27D4EB4FULL ) );
+	int clear[9];
+	int num_clear = 0;
+
+	if( m_safe_row >= 0 )
+	{
+		for( int r = m_safe_row - 1; r <= m_safe_row + 1; ++r )
+		{
+			for( int c = m_safe_col - 1; c <= m_safe_col + 1; ++c )
+			{
+				if( r >= first_row && r < first_row + rows && c >= first_col && c < first_col + cols )
+					clear[num_clear++] = ( ( r - first_row ) * cols ) + ( c - first_col );
+			}
+		}
+	}
+
+	const int num_cells = ( rows * cols ) - num_clear;
+	const int bombs = std::min( num_cells, static_cast<int>( ( static_cast<long long>( m_bombs ) * rows * cols ) /
+															 ChunkedArray2D<Cell>::TILE_CELLS ) );
+
+	for( int i = num_cells - bombs; i < num_cells; ++i )
+	{
+		int chosen = SkipClearCells( static_cast<int>( generator.NextBelow( i + 1 ) ), clear, num_clear );
+
+		if( ( mask[chosen / cols] >> ( chosen % cols ) ) & 1 )
+			chosen = SkipClearCells( i, clear, num_clear );
+
+		mask[chosen / cols] |= 1ULL << ( chosen % cols );
+	}
+}
+
+/***************************************************************
+*   Purpose: Writes the whole Board to a snapshot file: a 64 byte
+*			 header with the size, seed and counters, followed by
+*			 the Cells as they are stored in memory, one byte each.
+*			 A chunked Board only writes the tiles it has stored.
+*
+*     Entry: The path of the file, which is replaced if it exists.
+*
+*      Exit: Returns false if the file could not be written.
+****************************************************************/
+bool Board::Save( const char * path ) const
+{
+	SnapshotHeader header = SnapshotHeader();
+
+	memcpy( header.magic, SNAPSHOT_MAGIC, sizeof( header.magic ) );
+	header.version = SNAPSHOT_VERSION;
+	header.chunked = m_chunked ? 1 : 0;
+	header.rows = GetRows();
+	header.cols = GetCols();
+	header.bombs = m_bombs;
+	header.seed = m_seed;
+	header.num_covered = m_num_covered;
+	header.num_flags = m_num_flags;
+	header.num_revealed = m_num_revealed;
+	header.lost = m_lost ? 1 : 0;
+	header.safe_row = m_safe_row;
+	header.safe_col = m_safe_col;
+	header.loaded_bombs = m_loaded_bombs;
+	header.num_tiles = m_tiles.getNumTiles();
+
+	try
+	{
+		std::ofstream file( path, std::ios::binary | std::ios::trunc );
+
+		if( file.is_open() == false )
+			throw Exception( "ERROR: Could not create the snapshot file" );
+
+		file.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+
+		if( m_chunked )
+		{
+			for( int i = 0; i < m_tiles.getNumTiles(); ++i )
+			{
+				int coords[2];
+
+				m_tiles.getTileCoords( i, coords[0], coords[1] );
+				file.write( reinterpret_cast<const char *>( coords ), sizeof( coords ) );
+				file.write( reinterpret_cast<const char *>( m_tiles.TileData( i ) ),
+							ChunkedArray2D<Cell>::TILE_CELLS );
+			}
+		}
+		else
+		{
+			file.write( reinterpret_cast<const char *>( m_cells.data() ),
+						static_cast<std::streamsize>( m_cells.getRow() ) * m_cells.getColumn() );
+		}
+
+		file.close();
+
+		if( file.fail() )
+			throw Exception( "ERROR: Could not write the snapshot file" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Replaces the Board with the one in a snapshot file
+*			 written by Save(). The file is memory mapped, and a
+*			 plain Board uses the Cells right where they are in the
+*			 mapping instead of reading them in, so a huge Board
+*			 opens at once and its pages are read as play reaches
+*			 them. The mapping is copy-on-write, so play never
+*			 changes the file. The tiles of a chunked Board are
+*			 copied out of the mapping.
+*
+*     Entry: The path of the file.
+*
+*      Exit: Returns false if the file could not be read or is not
+*			 a snapshot of this version. The Board is unchanged
+*			 then.
+****************************************************************/
+bool Board::Load( const char * path )
+{
+	std::unique_ptr<MappedFile> file( new MappedFile() );
+	SnapshotHeader header;
+
+	try
+	{
+		file->Open( path );
+
+		if( file->size() < sizeof( header ) )
+			throw Exception( "ERROR: The file is not a board snapshot" );
+
+		memcpy( &header, file->data(), sizeof( header ) );
+
+		if( memcmp( header.magic, SNAPSHOT_MAGIC, sizeof( header.magic ) ) != 0 )
+			throw Exception( "ERROR: The file is not a board snapshot" );
+
+		if( header.version != SNAPSHOT_VERSION )
+			throw Exception( "ERROR: The snapshot was written by a different version" );
+
+		unsigned long long expected = sizeof( header );
+
+		if( header.chunked )
+			expected += static_cast<unsigned long long>( header.num_tiles ) * SNAPSHOT_TILE_BYTES;
+		else
+			expected += static_cast<unsigned long long>( header.rows ) * header.cols;
+
+		if( header.rows < 0 || header.cols < 0 || header.num_tiles < 0 || file->size() != expected ||
+			( header.chunked == 0 && static_cast<long long>( header.rows ) * header.cols > INT_MAX ) )
+		{
+			throw Exception( "ERROR: The snapshot is damaged" );
+		}
+
+		if( header.chunked )
+		{
+			ChunkedArray2D<Cell> bounds( header.rows, header.cols );
+			const unsigned char * tile = file->data() + sizeof( header );
+
+			for( int i = 0; i < header.num_tiles; ++i, tile += SNAPSHOT_TILE_BYTES )
+			{
+				int coords[2];
+
+				memcpy( coords, tile, sizeof( coords ) );
+
+				if( coords[0] < 0 || coords[0] >= bounds.getTileRows() ||
+					coords[1] < 0 || coords[1] >= bounds.getTileColumns() )
+				{
+					throw Exception( "ERROR: The snapshot is damaged" );
+				}
+			}
+		}
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	if( header.chunked )
+	{
+		const unsigned char * tile = file->data() + sizeof( header );
+
+		ResetChunked( header.rows, header.cols, header.bombs );
+
+		for( int i = 0; i < header.num_tiles; ++i, tile += SNAPSHOT_TILE_BYTES )
+		{
+			int coords[2];
+
+			memcpy( coords, tile, sizeof( coords ) );
+			memcpy( m_tiles.AddTile( coords[0], coords[1] ), tile + sizeof( coords ),
+					ChunkedArray2D<Cell>::TILE_CELLS );
+		}
+
+		// Nothing points into the old mapping any more
+		m_cells = Array2D<Cell>();
+		m_snapshot.reset();
+	}
+	else
+	{
+		m_tiles.Reset( 0, 0 );
+		m_chunked = false;
+		m_cells.UseMemory( reinterpret_cast<Cell *>( file->data() + sizeof( header ) ),
+						   header.rows, header.cols );
+		m_snapshot = std::move( file );
+	}
+
+	m_bombs = header.bombs;
+	m_seed = header.seed;
+	m_safe_row = header.safe_row;
+	m_safe_col = header.safe_col;
+	m_loaded_bombs = header.loaded_bombs;
+	m_num_covered = header.num_covered;
+	m_num_flags = header.num_flags;
+	m_num_revealed = header.num_revealed;
+	m_lost = ( header.lost != 0 );
+	m_changes.clear();
+	m_regions.reset();
+
+	return true;
 }
 
 /***************************************************************
@@ -390,7 +2049,7 @@ void Board::UncoverAllCells()
 *            
 *      Exit: True or false depending on if the cell is a bomb or not.
 ****************************************************************/
-bool Board::IsLoss( Cell cell )
+bool Board::IsLoss( const Cell & cell ) const
 {
 	bool lose = false;
 
@@ -9,11 +9,30 @@
 *		those arguments.
 *	Board( const Board & copy )
 *		Copy constructor for Board.
+*	Board( Board && move )
+*		Move constructor for Board. Takes over the other Board's Cells.
 *
 * METHODS:
 *	Board & operator=( const Board & rhs )
 *		Overloads the assignment operator so that two Board objects
-*		can be assigned to each other.
+*		can be assigned to each other. Reuses the memory of this Board's
+*		Cells when it is big enough.
+*	Board & operator=( Board && rhs )
+*		Move assignment. Takes over the other Board's Cells.
+*	void Reset( int rows, int cols, int bombs )
+*		Turns the Board into a new, empty Board of the given size, reusing
+*		its memory when it is big enough, so one Board can be used for
+*		game after game.
+*	void ResetChunked( int rows, int cols, int tile_bombs )
+*		Same as Reset(), but the Cells are kept in tiles of 64x64 that are
+*		only made when play first touches them, so rows and columns can go
+*		up to the largest int and the memory used grows with the area
+*		explored. Every full tile holds tile_bombs bombs, laid out from the
+*		seed and the tile's position when PlaceBombs() is called.
+*	bool IsChunked() const
+*		This method returns true if the Board was set up by ResetChunked().
+*	int GetNumTiles() const
+*		This method returns how many tiles of a chunked Board are stored.
 *	void SetRows( int rows )
 *		This method sets the total number of rows on the Board.
 *	void SetCols( int cols )
@@ -21,44 +40,149 @@
 *	void SetBombs( int bombs )
 *		This method sets the total number of bombs that will be placed
 *		on the Board.
+*	int GetBombs() const
+*		This method returns the total number of bombs on the Board, or
+*		the number in each full tile of a chunked Board.
 *	int GetRows()
 *		This method returns the total number of rows that the Board
 *		currently has.
-*	int GetCols()
+*	int GetCols() const
 *		This method returns the total number of columns that the Board
 *		currently has.
+*	const Cell & GetCell( int row, int col ) const
+*		This method returns the Cell at the given row and column so that
+*		its visible state can be read without going through the console.
+*		On a chunked Board a Cell in a tile that has not been made yet is
+*		returned as a covered Cell without a bomb.
+*	CellGrid GetGrid() const
+*		This method returns a read-only view of every Cell for the Solver
+*		and MineProbability. A chunked Board has no such view and returns
+*		an empty one.
 *	void SetNumber( int r, int c )
 *		This method will determine the number of bombs that it has
 *		surrounding it.
+*	void SetNumbers()
+*		This method recomputes the number of adjacent bombs for every
+*		Cell on the Board in a single pass.
 *	void PlaceBombs()
 *		This method will disperse the correct amount of bombs around
-*		the board depending on the difficulty.
+*		the board depending on the difficulty, using a fresh random seed.
+*	void PlaceBombs( unsigned long long seed )
+*		Same as PlaceBombs(), but uses the seed passed in. The same seed
+*		always gives the same board, and the time taken depends only on
+*		the number of bombs, not on how dense they are.
+*	void PlaceBombs( unsigned long long seed, int safe_row, int safe_col )
+*		Same as PlaceBombs( seed ), but keeps the given Cell and the Cells
+*		around it free of bombs so that a first click there opens an area.
+*	void LabelRegions()
+*		This method finds the blank regions once the bombs are placed, so
+*		that a click on a blank Cell uncovers its region straight from a
+*		list instead of searching the Board. The labels are dropped when
+*		the bombs or numbers change. A chunked Board is not labelled.
+*	bool HasRegions() const
+*		This method returns true if the blank regions are labelled.
+*	unsigned long long GetSeed() const
+*		This method returns the seed that the bombs were placed with.
+*	bool GetSafeCell( int & row, int & col ) const
+*		This method gets the Cell that PlaceBombs() kept clear. Returns
+*		false if none was.
+*	unsigned int GetChecksum() const
+*		This method returns a checksum of every Cell's state, so that two
+*		Boards can be compared quickly.
+*	void SetJournal( Journal * journal )
+*		This method makes ProcessCell() record every action on a Cell of
+*		the Board in the given Journal, or stops recording if it is
+*		nullptr.
 *	int DisplayBoard()
 *		This method will display the current Board according to flags
-*		that are set in the Cell objects.
+*		that are set in the Cell objects. A chunked Board is refused; the
+*		Viewport draws those.
 *	bool ProcessCells( const char r, const char c, char action )
 *		This method processes the users input as to which Cell they want
-*		to modify (uncover or toggle flag) and sets the Cell's flags
-*		accordingly.
+*		to modify (uncover, toggle flag or chord) and sets the Cell's
+*		flags accordingly.
+*	bool ProcessCell( int row, int col, char action )
+*		Same as ProcessCells(), but takes the row and column as numbers
+*		instead of the characters typed in by the user.
+*	bool ProcessActions( const std::vector<BoardAction> & actions,
+*						 std::vector<int> & changed )
+*		This method carries out a whole list of actions in one call, with
+*		a single cascade for all of them, and stores the Cells that
+*		changed in changed. Returns true if a bomb was uncovered, in which
+*		case the actions after it are not carried out.
 *	int ConvertCoords( char x )
 *		This method converts the coordinate that is passed in from a char
 *		to an int.
-*	bool CascadeCells( int row, int col )
+*	int CascadeCells( int row, int col )
 *		This method reveals all blank Cells around the selected cell if
-*		the selected Cell is blank.
+*		the selected Cell is blank and returns how many Cells it revealed.
+*	void SetCascadeThreads( int threads )
+*		This method sets how many threads a cascade that opens a very big
+*		area is spread across. 0 (the default) means one per core and 1
+*		keeps every cascade on the calling thread.
 *	void UncoverAllCells()
 *		This function marks all spaces as uncoverd for when the player
 *		losses so that they can see the entire board.
-*	bool IsLoss( Cell cell )
-*		This method detects whether the Cell that is passed in is a bomb.
+*	int GetNumCovered() const
+*		This method returns the number of Cells that are still covered
+*		(flagged Cells count as covered) without displaying the Board. On
+*		a chunked Board only the stored tiles are counted.
+*	int GetNumFlags() const
+*		This method returns the number of covered Cells that are flagged.
+*	int GetNumRevealed() const
+*		This method returns the number of safe Cells that are uncovered.
+*	bool IsWon() const
+*		This method returns true once every safe Cell is uncovered.
+*	bool IsLost() const
+*		This method returns true once the player has uncovered a bomb.
+*	void TrackChanges( bool track )
+*		This method turns the recording of changed Cells on or off. A
+*		chunked Board never records them.
+*	const std::vector<int> & GetChangedCells() const
+*		This method returns the Cells that were uncovered or had their
+*		flag toggled since the list was last cleared.
+*	void ClearChangedCells()
+*		This method empties the list of changed Cells.
+*	bool Save( const char * path ) const
+*		This method writes the whole Board to a snapshot file. Returns
+*		false if the file could not be written.
+*	bool Load( const char * path )
+*		This method replaces the Board with the one in a snapshot file.
+*		Returns false, leaving the Board alone, if the file could not be
+*		read. The Cells of a plain Board stay in the mapped file and are
+*		only read from disk as they are used.
+*	bool IsLoss( const Cell & cell ) const
+*		This method detects whether the Cell that is passed in is an
+*		uncovered bomb.
 *	~Board()
 *		This method destructs the class.
+*
+* NOTES:
+*	An action is 'U' to uncover a Cell, 'C' to chord it or anything else
+*	to toggle its flag. Chording an uncovered number whose count of
+*	flagged neighbours matches it uncovers every other covered neighbour;
+*	otherwise it does nothing.
 *************************************************************************/
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <memory>
+#include <vector>
 #include "Array2D.h"
 #include "Cell.h"
+#include "CellGrid.h"
+#include "ChunkedArray2D.h"
+#include "MappedFile.h"
+
+class Journal;
+class ZeroRegions;
+
+struct BoardAction
+{
+	int  row;
+	int  col;
+	char action; // 'U', 'F' or 'C', as passed to ProcessCell()
+};
 
 class Board
 {
@@ -66,25 +190,93 @@ class Board
 		Board();
 		Board( int rows, int cols, int bombs );
 		Board( const Board & copy );
+		Board( Board && move ) noexcept;
 		Board & operator=( const Board & rhs );
+		Board & operator=( Board && rhs ) noexcept;
+		void Reset( int rows, int cols, int bombs );
+		void ResetChunked( int rows, int cols, int tile_bombs );
+		bool IsChunked() const;
+		int  GetNumTiles() const;
 		void SetRows( int rows );
 		void SetCols( int cols );
 		void SetBombs( int bombs );
+		int  GetBombs() const;
 		int  GetRows() const;
-		int  GetCols();
+		int  GetCols() const;
+		const Cell & GetCell( int row, int col ) const;
+		CellGrid GetGrid() const;
 		void SetNumber( int r, int c );
+		void SetNumbers();
 		void PlaceBombs();
+		void PlaceBombs( unsigned long long seed );
+		void PlaceBombs( unsigned long long seed, int safe_row, int safe_col );
+		void LabelRegions();
+		bool HasRegions() const;
+		unsigned long long GetSeed() const;
+		bool GetSafeCell( int & row, int & col ) const;
+		unsigned int GetChecksum() const;
+		void SetJournal( Journal * journal );
 		int  DisplayBoard();
 		bool ProcessCells( const char r, const char c, char action );
+		bool ProcessCell( int row, int col, char action );
+		bool ProcessActions( const std::vector<BoardAction> & actions, std::vector<int> & changed );
 		int  ConvertCoords( char x );
-		void CascadeCells( int row, int col );
+		int  CascadeCells( int row, int col );
+		void SetCascadeThreads( int threads );
 		void UncoverAllCells();
-		bool IsLoss( Cell cell );
+		int  GetNumCovered() const;
+		int  GetNumFlags() const;
+		int  GetNumRevealed() const;
+		bool IsWon() const;
+		bool IsLost() const;
+		void TrackChanges( bool track );
+		const std::vector<int> & GetChangedCells() const;
+		void ClearChangedCells();
+		bool Save( const char * path ) const;
+		bool Load( const char * path );
+		bool IsLoss( const Cell & cell ) const;
 		~Board();
 
 	private:
+		static void SumBombColumns( const unsigned char * above,
+									const unsigned char * row,
+									const unsigned char * below,
+									unsigned char * sums, int cols );
+		static void WriteBombCounts( const unsigned char * sums,
+									 unsigned char * row, int cols );
+		void PlaceBombsAvoiding( unsigned long long seed, int safe_row, int safe_col );
+		int  CascadeTiles( int row, int col );
+		bool ApplyAction( int row, int col, char action );
+		bool ChordCell( int row, int col );
+		void RevealSeed( int row, int col );
+		void DrainCascade();
+		bool SpreadInParallel();
+		static int SkipClearCells( int index, const int * clear, int num_clear );
+		void RevealCell( Cell & cell, int index );
+		void RecountCells();
+		Cell & At( int row, int col );
+		Cell * LoadTile( int tile_row, int tile_col );
+		void TileBombs( int tile_row, int tile_col, unsigned long long * mask ) const;
+
 		Array2D <Cell> m_cells;
+		ChunkedArray2D <Cell> m_tiles; // Used instead of m_cells when m_chunked
+		bool m_chunked;
 		int m_bombs;
+		unsigned long long m_seed;
+		int  m_safe_row;     // First click kept clear by PlaceBombs(), or -1
+		int  m_safe_col;
+		int  m_loaded_bombs; // Bombs in the stored tiles of a chunked Board
+		int  m_num_covered;  // Covered Cells, flagged or not
+		int  m_num_flags;    // Covered Cells that are flagged
+		int  m_num_revealed; // Safe Cells uncovered by play
+		bool m_lost;         // A bomb has been uncovered
+		bool m_track_changes;
+		std::vector<int> m_changes; // Cells changed since ClearChangedCells()
+		std::vector<int> m_cascade; // Work stack reused by CascadeCells
+		int  m_cascade_threads;     // Threads for a big cascade, 0 for one per core
+		std::shared_ptr<const ZeroRegions> m_regions; // From LabelRegions(), shared by copies
+		std::unique_ptr<MappedFile> m_snapshot; // File m_cells uses after Load()
+		Journal * m_journal; // Where ProcessCell() records actions, if anywhere
 };
 
 #endif
\ No newline at end of file
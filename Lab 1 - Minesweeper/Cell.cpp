@@ -1,8 +1,6 @@
-#include <Windows.h>
-#include <iostream>
 #include "Cell.h"
-
-using std::cout;
+#include "GlyphTable.h"
+#include "Terminal.h"
 
 /***************************************************************
 *   Purpose: Default constructor for Cell.
@@ -11,54 +9,23 @@ using std::cout;
 *            
 *      Exit: None
 ****************************************************************/
-Cell::Cell() : m_covered( true ), m_bomb( false ), m_num_bombs( 0 ),
-			   m_flag( false )
-{ }
-
-/***************************************************************
-*   Purpose: Copy constructor for Cell
-*            
-*     Entry: The Cell to be copied to this new instance.
-*            
-*      Exit: None
-****************************************************************/
-Cell::Cell( const Cell & copy ) : m_covered( copy.m_covered ),
-								  m_bomb( copy.m_bomb ), m_flag( copy.m_flag ),
-								  m_num_bombs( copy.m_num_bombs )
+Cell::Cell() : m_state( COVERED_BIT )
 { }
 
-/***************************************************************
-*   Purpose: Overloads the assignment operator so that two Cell
-*			 objects can be assigned to each other.
-*            
-*     Entry: The right hand side of the assignment operator.
-*            
-*      Exit: Returns a reference to the new Cell.
-****************************************************************/
-Cell & Cell::operator=( const Cell & rhs )
-{
-	m_covered = rhs.m_covered;
-	m_bomb = rhs.m_bomb;
-	m_flag = rhs.m_flag;
-	m_num_bombs = rhs.m_num_bombs;
-
-	return *this;
-}
-
 /***************************************************************
 *   Purpose: This method sets whether the Cell has been flagged
 *			 or not.
 *            
-*     Entry: A character representing what to set m_flag to.
+*     Entry: A character representing whether the flag bit is set.
 *            
 *      Exit: None
 ****************************************************************/
 void Cell::SetFlag( char flag )
 {
 	if( flag == 'T' )
-		m_flag = true;
+		m_state |= FLAG_BIT;
 	else
-		m_flag = false;
+		m_state &= ~FLAG_BIT;
 }
 
 /***************************************************************
@@ -70,7 +37,7 @@ void Cell::SetFlag( char flag )
 ****************************************************************/
 void Cell::SetBomb()
 {
-	m_bomb = true;
+	m_state |= BOMB_BIT;
 }
 
 /***************************************************************
@@ -78,13 +45,15 @@ void Cell::SetBomb()
 *			 adjacent to this Cell according to the number that
 *			 is passed in.
 *            
-*     Entry: The number of bombs that are adjacent to this Cell.
+*     Entry: The number of bombs that are adjacent to this Cell
+*			 (0 through 8).
 *            
 *      Exit: None
 ****************************************************************/
 void Cell::SetNumBombs( int num )
 {
-	m_num_bombs = num;
+	m_state = static_cast<unsigned char>( ( m_state & ~NUM_BOMBS_MASK ) |
+										  ( num & NUM_BOMBS_MASK ) );
 }
 
 /***************************************************************
@@ -97,7 +66,7 @@ void Cell::SetNumBombs( int num )
 ****************************************************************/
 int Cell::GetNumBombs() const
 {
-	return m_num_bombs;
+	return m_state & NUM_BOMBS_MASK;
 }
 
 /***************************************************************
@@ -109,7 +78,7 @@ int Cell::GetNumBombs() const
 ****************************************************************/
 void Cell::Uncover()
 {
-	m_covered = false;
+	m_state &= ~COVERED_BIT;
 }
 
 /***************************************************************
@@ -120,14 +89,9 @@ void Cell::Uncover()
 *            
 *      Exit: Returns true if this Cell is a bomb and false if not.
 ****************************************************************/
-bool Cell::IsBomb()
+bool Cell::IsBomb() const
 {
-	bool is_bomb = false;
-
-	if( m_bomb == true )
-		is_bomb = true;
-
-	return is_bomb;
+	return ( m_state & BOMB_BIT ) != 0;
 }
 
 /***************************************************************
@@ -138,14 +102,9 @@ bool Cell::IsBomb()
 *            
 *      Exit: Returns true if this Cell is a bomb and false if not.
 ****************************************************************/
-bool Cell::IsFlagged()
+bool Cell::IsFlagged() const
 {
-	bool is_flagged = false;
-
-	if( m_flag == true )
-		is_flagged = true;
-
-	return is_flagged;
+	return ( m_state & FLAG_BIT ) != 0;
 }
 
 /***************************************************************
@@ -156,80 +115,59 @@ bool Cell::IsFlagged()
 *            
 *      Exit: Returns true if this Cell is covered and false if not.
 ****************************************************************/
-bool Cell::IsCovered()
+bool Cell::IsCovered() const
 {
-	bool is_covered = false;
-
-	if( m_covered == true )
-		is_covered = true;
-
-	return is_covered;
+	return ( m_state & COVERED_BIT ) != 0;
 }
 
 /***************************************************************
 *   Purpose: This method displays the correct character depending
 *			 on what flags are currently set on.
 *            
-*     Entry: None
+*     Entry: The Terminal to print the Cell into.
 *            
 *      Exit: Returns true if the Cell is still technically coverd
 *			 and false if not (Flagged is still covered).
 ****************************************************************/
-bool Cell::Display()
+bool Cell::Display( Terminal & terminal ) const
 {
-	HANDLE handle = 0;
-	const int DEFAULT = 7;
-	const int YELLOW = 14;
-	const int GREEN = 10;
-	const int RED = 12;
-	const int BLUE = 9;
-	bool empty = false;
+	// The same symbols and colours as the Renderer and Viewport
+	static const GlyphTable glyphs;
+	const Glyph & glyph = glyphs[m_state];
 
-	handle = GetStdHandle( STD_OUTPUT_HANDLE );
-
-	if( m_covered == false )
-	{
-		if( m_bomb == true )
-		{
-			SetConsoleTextAttribute( handle, RED );
-			cout << "X ";
-			SetConsoleTextAttribute( handle, DEFAULT );
-		}
-		else if( m_num_bombs > 0 )
-		{
-			SetConsoleTextAttribute( handle, GREEN );
-			cout << m_num_bombs << ' ';
-			SetConsoleTextAttribute( handle, DEFAULT );
-		}
-		else
-		{
-			SetConsoleTextAttribute( handle, BLUE );
-			cout << ". ";
-			SetConsoleTextAttribute( handle, DEFAULT );
-		}
-	}
-	else if( m_flag == true )
-	{
-		SetConsoleTextAttribute( handle, YELLOW );
-		cout << "F ";
-		SetConsoleTextAttribute( handle, DEFAULT );
-		empty = true;
-	}
-	else
-	{
-		cout << "? ";
-		empty = true;
-	}
+	terminal.SetColor( static_cast<Terminal::Color>( glyph.color ) );
+	terminal.Print( glyph.symbol );
+	terminal.Print( ' ' );
 
-	return empty;
+	return glyph.covered;
 }
 
 /***************************************************************
-*   Purpose: This method destructs the class.
+*   Purpose: This method returns the character that Display()
+*			 would show for the Cell, without writing anything to
+*			 the console.
 *            
 *     Entry: None
 *            
-*      Exit: None
+*      Exit: Returns 'X' for an uncovered bomb, '1' to '8' for an
+*			 uncovered number, '.' for an uncovered blank, 'F' for
+*			 a flag and '?' for a covered Cell.
 ****************************************************************/
-Cell::~Cell()
-{ }
\ No newline at end of file
+char Cell::GetSymbol() const
+{
+	char symbol = '?';
+
+	if( IsCovered() == false )
+	{
+		if( IsBomb() )
+			symbol = 'X';
+		else if( GetNumBombs() > 0 )
+			symbol = static_cast<char>( '0' + GetNumBombs() );
+		else
+			symbol = '.';
+	}
+	else if( IsFlagged() )
+		symbol = 'F';
+
+	return symbol;
+}
@@ -23,46 +23,68 @@
 *	int GetNumBombs() const
 *		This method returns the number of bombs that are adjacent to this
 *		Cell.
-*	bool IsBomb()
+*	bool IsBomb() const
 *		This method returns true or false as to whether it is a bomb Cell
 *		or not.
-*	bool IsFlagged()
+*	bool IsFlagged() const
 *		This method returns true or false as to whether it is a flagged
 *		Cell or not.
-*	bool IsCovered()
+*	bool IsCovered() const
 *		This method returns true or false as to whether it is covered or
 *		not.
-*	void Display()
-*		This method displays the correct character depending on what flags
-*		are currently set on.
+*	bool Display( Terminal & terminal ) const
+*		This method prints the correct character depending on what flags
+*		are currently set on into the Terminal.
+*	char GetSymbol() const
+*		This method returns the character that Display() would show for
+*		the Cell, without writing anything to the console.
 *	~Cell()
 *		This method destructs the class.
+*
+* STORAGE:
+*	The whole state of a Cell is packed into a single byte so that a
+*	board of N cells takes N bytes. The low four bits hold the number
+*	of adjacent bombs (0-8) and the high bits hold the bomb, covered
+*	and flag states (see the *_BIT constants). Copying, assignment and
+*	destruction are the compiler's own, so a Cell is trivially copyable
+*	and whole Boards can be copied with memcpy().
 *************************************************************************/
 #ifndef CELL_H
 #define CELL_H
 
+#include <type_traits>
+
+class Terminal;
+
 class Cell
 {
 	public:
 		Cell();
-		Cell( const Cell & copy );
-		Cell & operator=( const Cell & rhs );
+		Cell( const Cell & copy ) = default;
+		Cell & operator=( const Cell & rhs ) = default;
 		void SetFlag( char flag );
 		void SetBomb();
 		void SetNumBombs( int num );
 		int  GetNumBombs() const;
 		void Uncover();
-		bool IsBomb();
-		bool IsFlagged();
-		bool IsCovered();
-		bool Display();
-		~Cell();
+		bool IsBomb() const;
+		bool IsFlagged() const;
+		bool IsCovered() const;
+		bool Display( Terminal & terminal ) const;
+		char GetSymbol() const;
+		~Cell() = default;
+
+		static const unsigned char NUM_BOMBS_MASK = 0x0F;
+		static const unsigned char BOMB_BIT = 0x10;
+		static const unsigned char COVERED_BIT = 0x20;
+		static const unsigned char FLAG_BIT = 0x40;
 
 	private:
-		bool m_covered;
-		bool m_bomb;
-		bool m_flag;
-		int  m_num_bombs;
+		unsigned char m_state;
 };
 
+static_assert( sizeof( Cell ) == 1, "Cell must stay packed into a single byte" );
+static_assert( std::is_trivially_copyable<Cell>::value,
+			   "Boards, snapshots and journals copy Cells as raw bytes" );
+
 #endif
\ No newline at end of file
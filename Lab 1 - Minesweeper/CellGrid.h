@@ -0,0 +1,110 @@
+/************************************************************************
+* CLASS: CellGrid
+*
+* CONSTRUCTORS:
+*	CellGrid()
+*		Default constructor for CellGrid. It shows no Cells.
+*	CellGrid( const Cell * first, int rows, int cols, int stride, int bombs )
+*		Shows the Cells of a board that keeps them in row order, with
+*		stride Cells from the start of one row to the start of the next.
+*
+* METHODS:
+*	const Cell & GetCell( int row, int col ) const
+*		Gets the Cell at the given row and column. Nothing is checked.
+*	int GetRows() const
+*		Gets the number of rows.
+*	int GetCols() const
+*		Gets the number of columns.
+*	int GetBombs() const
+*		Gets the number of bombs on the board.
+*
+* NOTES:
+*	A CellGrid is a read-only view of the Cells of a Board or a
+*	FixedBoard, so that the Solver and MineProbability can read either
+*	one straight from its memory. It is only valid until the board is
+*	reset, loaded or destroyed.
+*************************************************************************/
+#ifndef CELLGRID_H
+#define CELLGRID_H
+
+#include "Cell.h"
+
+class CellGrid
+{
+	public:
+		CellGrid();
+		CellGrid( const Cell * first, int rows, int cols, int stride, int bombs );
+		const Cell & GetCell( int row, int col ) const;
+		int GetRows() const;
+		int GetCols() const;
+		int GetBombs() const;
+
+	private:
+		const Cell * m_first; // The Cell in row 0, column 0
+		int m_rows;
+		int m_cols;
+		int m_stride;         // Cells from one row to the next
+		int m_bombs;
+};
+
+/***************************************************************
+*   Purpose: Default constructor for CellGrid. It shows no Cells.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+inline CellGrid::CellGrid() : m_first( nullptr ), m_rows( 0 ), m_cols( 0 ), m_stride( 0 ),
+							  m_bombs( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Shows the Cells of a board kept in row order.
+*
+*     Entry: The Cell in row 0, column 0, the size of the board,
+*			 the distance in Cells from one row to the next and the
+*			 number of bombs.
+*
+*      Exit: None
+****************************************************************/
+inline CellGrid::CellGrid( const Cell * first, int rows, int cols, int stride, int bombs )
+	: m_first( first ), m_rows( rows ), m_cols( cols ), m_stride( stride ), m_bombs( bombs )
+{ }
+
+/***************************************************************
+*   Purpose: Gets the Cell at the given row and column.
+*
+*     Entry: A row and column on the board.
+*
+*      Exit: Returns the Cell.
+****************************************************************/
+inline const Cell & CellGrid::GetCell( int row, int col ) const
+{
+	return m_first[( row * m_stride ) + col];
+}
+
+/***************************************************************
+*   Purpose: Gets the number of rows.
+****************************************************************/
+inline int CellGrid::GetRows() const
+{
+	return m_rows;
+}
+
+/***************************************************************
+*   Purpose: Gets the number of columns.
+****************************************************************/
+inline int CellGrid::GetCols() const
+{
+	return m_cols;
+}
+
+/***************************************************************
+*   Purpose: Gets the number of bombs on the board.
+****************************************************************/
+inline int CellGrid::GetBombs() const
+{
+	return m_bombs;
+}
+
+#endif
@@ -0,0 +1,465 @@
+/************************************************************************
+* CLASS: ChunkedArray2D
+*
+* CONSTRUCTORS:
+*	ChunkedArray2D()
+*		Default constructor for ChunkedArray2D. Defaults are 0.
+*	ChunkedArray2D( int row, int col )
+*		Sets the total number of rows and columns. No memory is taken
+*		until a tile is added.
+*	ChunkedArray2D( const ChunkedArray2D & copy )
+*		Copy constructor for ChunkedArray2D.
+*	ChunkedArray2D( ChunkedArray2D && move )
+*		Move constructor for ChunkedArray2D. Takes over the other array's
+*		tiles.
+*
+* METHODS:
+*	ChunkedArray2D & operator=( const ChunkedArray2D & rhs )
+*		Overloads the assignment operator so that two ChunkedArray2D
+*		objects can be assigned to each other.
+*	ChunkedArray2D & operator=( ChunkedArray2D && rhs )
+*		Move assignment. Takes over the other array's tiles.
+*	int getRow() const
+*		Gets the total number of rows there are.
+*	int getColumn() const
+*		Gets the total number of columns there are.
+*	int getTileRows() const
+*	int getTileColumns() const
+*		Gets how many tiles it takes to cover the rows or the columns.
+*	void Reset( int rows, int columns )
+*		Sets both sizes at once and drops every tile. The memory of the
+*		tiles is kept for the next ones that are added.
+*	T * FindTile( int tile_row, int tile_col )
+*	const T * FindTile( int tile_row, int tile_col ) const
+*		Gets the first element of a tile, or nullptr if the tile has not
+*		been added. The elements of a tile are stored row by row,
+*		TILE_SIZE to a row.
+*	T * AddTile( int tile_row, int tile_col )
+*		Adds a tile of default values and gets its first element. If the
+*		tile is already there it is returned as it is.
+*	int getNumTiles() const
+*		Gets how many tiles have been added.
+*	T * TileData( int index )
+*	const T * TileData( int index ) const
+*		Gets the first element of the tile added index-th, so that every
+*		tile can be walked.
+*	void getTileCoords( int index, int & tile_row, int & tile_col ) const
+*		Gets the position of the tile added index-th.
+*	~ChunkedArray2D()
+*		Sets the total columns and rows to 0.
+*
+* NOTES:
+*	The array is split into square tiles of TILE_SIZE x TILE_SIZE that
+*	are only stored once they are added, so the memory used grows with
+*	the number of tiles touched rather than with rows * columns. A tile
+*	at the bottom or right edge is stored full size; the elements past
+*	the edge are never used.
+*************************************************************************/
+#ifndef  CHUNKEDARRAY2D_H
+#define  CHUNKEDARRAY2D_H
+#include "Array.h"
+#include "Exception.h"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+template<class T>
+class ChunkedArray2D
+{
+	public:
+		static const int TILE_SIZE = 64;
+		static const int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+
+		ChunkedArray2D();
+		ChunkedArray2D( int row, int col );
+		ChunkedArray2D( const ChunkedArray2D & copy );
+		ChunkedArray2D( ChunkedArray2D && move ) noexcept;
+		ChunkedArray2D & operator=( const ChunkedArray2D & rhs );
+		ChunkedArray2D & operator=( ChunkedArray2D && rhs ) noexcept;
+		int getRow() const;
+		int getColumn() const;
+		int getTileRows() const;
+		int getTileColumns() const;
+		void Reset( int rows, int columns );
+		T * FindTile( int tile_row, int tile_col );
+		const T * FindTile( int tile_row, int tile_col ) const;
+		T * AddTile( int tile_row, int tile_col );
+		int getNumTiles() const;
+		T * TileData( int index );
+		const T * TileData( int index ) const;
+		void getTileCoords( int index, int & tile_row, int & tile_col ) const;
+		~ChunkedArray2D();
+
+	private:
+		static long long TileKey( int tile_row, int tile_col );
+
+		std::vector<Array<T> > m_tiles;  // Tiles past m_num_tiles are kept for reuse
+		std::vector<long long> m_keys;   // Position of each tile
+		std::unordered_map<long long, int> m_index;
+		int m_num_tiles;
+		int m_row;
+		int m_col;
+};
+
+/***************************************************************
+*   Purpose: Default constructor for ChunkedArray2D. Defaults are 0.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+template<class T>
+ChunkedArray2D<T>::ChunkedArray2D() : m_num_tiles( 0 ), m_row( 0 ), m_col( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Sets the total number of rows and columns. No tile is
+*			 stored until it is added.
+*
+*     Entry: The total number of rows and columns.
+*
+*      Exit: None
+****************************************************************/
+template<class T>
+ChunkedArray2D<T>::ChunkedArray2D( int row, int col ) : m_num_tiles( 0 ), m_row( 0 ), m_col( 0 )
+{
+	Reset( row, col );
+}
+
+/***************************************************************
+*   Purpose: Copy constructor for ChunkedArray2D.
+*
+*     Entry: The ChunkedArray2D object to be copied into this
+*			 instance.
+*
+*      Exit: None
+****************************************************************/
+template<class T>
+ChunkedArray2D<T>::ChunkedArray2D( const ChunkedArray2D & copy ) : m_tiles( copy.m_tiles ),
+																   m_keys( copy.m_keys ),
+																   m_index( copy.m_index ),
+																   m_num_tiles( copy.m_num_tiles ),
+																   m_row( copy.m_row ),
+																   m_col( copy.m_col )
+{ }
+
+/***************************************************************
+*   Purpose: Move constructor for ChunkedArray2D. Takes over the
+*			 tiles of the ChunkedArray2D passed in.
+*
+*     Entry: The ChunkedArray2D object to be moved from.
+*
+*      Exit: The other ChunkedArray2D is left with no tiles, rows
+*			 or columns.
+****************************************************************/
+template<class T>
+ChunkedArray2D<T>::ChunkedArray2D( ChunkedArray2D && move ) noexcept
+	: m_tiles( std::move( move.m_tiles ) ),
+	  m_keys( std::move( move.m_keys ) ),
+	  m_index( std::move( move.m_index ) ),
+	  m_num_tiles( move.m_num_tiles ),
+	  m_row( move.m_row ),
+	  m_col( move.m_col )
+{
+	move.m_index.clear();
+	move.m_num_tiles = 0;
+	move.m_row = 0;
+	move.m_col = 0;
+}
+
+/***************************************************************
+*   Purpose: Overloads the assignment operator so that two
+*			 ChunkedArray2D objects can be assigned to each other.
+*
+*     Entry: The right hand side of the assignment operator.
+*
+*      Exit: Returns a reference to this ChunkedArray2D.
+****************************************************************/
+template<class T>
+ChunkedArray2D<T> & ChunkedArray2D<T>::operator=( const ChunkedArray2D & rhs )
+{
+	if( this != &rhs )
+	{
+		m_tiles = rhs.m_tiles;
+		m_keys = rhs.m_keys;
+		m_index = rhs.m_index;
+		m_num_tiles = rhs.m_num_tiles;
+		m_row = rhs.m_row;
+		m_col = rhs.m_col;
+	}
+
+	return *this;
+}
+
+/***************************************************************
+*   Purpose: Move assignment. Takes over the tiles of the
+*			 ChunkedArray2D passed in.
+*
+*     Entry: The right hand side of the assignment operator.
+*
+*      Exit: Returns a reference to this ChunkedArray2D. The other
+*			 one is left with no tiles, rows or columns.
+****************************************************************/
+template<class T>
+ChunkedArray2D<T> & ChunkedArray2D<T>::operator=( ChunkedArray2D && rhs ) noexcept
+{
+	if( this != &rhs )
+	{
+		m_tiles = std::move( rhs.m_tiles );
+		m_keys = std::move( rhs.m_keys );
+		m_index = std::move( rhs.m_index );
+		m_num_tiles = rhs.m_num_tiles;
+		m_row = rhs.m_row;
+		m_col = rhs.m_col;
+
+		rhs.m_index.clear();
+		rhs.m_num_tiles = 0;
+		rhs.m_row = 0;
+		rhs.m_col = 0;
+	}
+
+	return *this;
+}
+
+/***************************************************************
+*   Purpose: Gets the total number of rows there are.
+*
+*     Entry: None
+*
+*      Exit: Returns the total number of rows.
+****************************************************************/
+template<class T>
+int ChunkedArray2D<T>::getRow() const
+{
+	return m_row;
+}
+
+/***************************************************************
+*   Purpose: Gets the total number of columns there are.
+*
+*     Entry: None
+*
+*      Exit: Returns the total number of columns.
+****************************************************************/
+template<class T>
+int ChunkedArray2D<T>::getColumn() const
+{
+	return m_col;
+}
+
+/***************************************************************
+*   Purpose: Gets how many tiles it takes to cover the rows.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of tile rows.
+****************************************************************/
+template<class T>
+int ChunkedArray2D<T>::getTileRows() const
+{
+	return ( m_row / TILE_SIZE ) + ( m_row % TILE_SIZE != 0 );
+}
+
+/***************************************************************
+*   Purpose: Gets how many tiles it takes to cover the columns.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of tile columns.
+****************************************************************/
+template<class T>
+int ChunkedArray2D<T>::getTileColumns() const
+{
+	return ( m_col / TILE_SIZE ) + ( m_col % TILE_SIZE != 0 );
+}
+
+/***************************************************************
+*   Purpose: Sets both sizes at once and drops every tile. The
+*			 memory of the dropped tiles is reused by the next
+*			 tiles that are added.
+*
+*     Entry: The new number of rows and columns.
+*
+*      Exit: No tile is stored.
+****************************************************************/
+template<class T>
+void ChunkedArray2D<T>::Reset( int rows, int columns )
+{
+	if( rows < 0 || columns < 0 )
+		throw Exception( "ERROR: Cannot have negative amount of rows or columns" );
+
+	m_row = rows;
+	m_col = columns;
+	m_num_tiles = 0;
+	m_keys.clear();
+	m_index.clear();
+}
+
+/***************************************************************
+*   Purpose: Gets the first element of a tile if it has been
+*			 added.
+*
+*     Entry: The row and column of the tile.
+*
+*      Exit: Returns the tile, or nullptr if it is not stored.
+****************************************************************/
+template<class T>
+T * ChunkedArray2D<T>::FindTile( int tile_row, int tile_col )
+{
+	typename std::unordered_map<long long, int>::const_iterator found =
+		m_index.find( TileKey( tile_row, tile_col ) );
+
+	if( found == m_index.end() )
+		return nullptr;
+
+	return m_tiles[found->second].data();
+}
+
+/***************************************************************
+*   Purpose: Gets the first element of a tile if it has been
+*			 added. *For CONSTANT objects.
+*
+*     Entry: The row and column of the tile.
+*
+*      Exit: Returns the tile, or nullptr if it is not stored.
+****************************************************************/
+template<class T>
+const T * ChunkedArray2D<T>::FindTile( int tile_row, int tile_col ) const
+{
+	typename std::unordered_map<long long, int>::const_iterator found =
+		m_index.find( TileKey( tile_row, tile_col ) );
+
+	if( found == m_index.end() )
+		return nullptr;
+
+	return m_tiles[found->second].data();
+}
+
+/***************************************************************
+*   Purpose: Adds a tile of default values, reusing the memory
+*			 of a dropped tile when there is one.
+*
+*     Entry: The row and column of the tile.
+*
+*      Exit: Returns the new tile, or the tile that was already
+*			 there.
+****************************************************************/
+template<class T>
+T * ChunkedArray2D<T>::AddTile( int tile_row, int tile_col )
+{
+	if( tile_row < 0 || tile_row >= getTileRows() || tile_col < 0 || tile_col >= getTileColumns() )
+		throw Exception( "ERROR: Tile out of bounds" );
+
+	T * tile = FindTile( tile_row, tile_col );
+
+	if( tile != nullptr )
+		return tile;
+
+	if( m_num_tiles == static_cast<int>( m_tiles.size() ) )
+		m_tiles.push_back( Array<T>( TILE_CELLS ) );
+	else
+	{
+		for( T & element : m_tiles[m_num_tiles] )
+			element = T();
+	}
+
+	m_keys.push_back( TileKey( tile_row, tile_col ) );
+	m_index[m_keys.back()] = m_num_tiles;
+
+	return m_tiles[m_num_tiles++].data();
+}
+
+/***************************************************************
+*   Purpose: Gets how many tiles have been added.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of stored tiles.
+****************************************************************/
+template<class T>
+int ChunkedArray2D<T>::getNumTiles() const
+{
+	return m_num_tiles;
+}
+
+/***************************************************************
+*   Purpose: Gets the first element of the tile that was added
+*			 index-th.
+*
+*     Entry: The index, from 0 to getNumTiles() - 1.
+*
+*      Exit: Returns the tile.
+****************************************************************/
+template<class T>
+T * ChunkedArray2D<T>::TileData( int index )
+{
+	if( index < 0 || index >= m_num_tiles )
+		throw Exception( "ERROR: Tile out of bounds" );
+
+	return m_tiles[index].data();
+}
+
+/***************************************************************
+*   Purpose: Gets the first element of the tile that was added
+*			 index-th. *For CONSTANT objects.
+*
+*     Entry: The index, from 0 to getNumTiles() - 1.
+*
+*      Exit: Returns the tile.
+****************************************************************/
+template<class T>
+const T * ChunkedArray2D<T>::TileData( int index ) const
+{
+	if( index < 0 || index >= m_num_tiles )
+		throw Exception( "ERROR: Tile out of bounds" );
+
+	return m_tiles[index].data();
+}
+
+/***************************************************************
+*   Purpose: Gets the position of the tile that was added
+*			 index-th.
+*
+*     Entry: The index and where to store the tile's row and
+*			 column.
+*
+*      Exit: None
+****************************************************************/
+template<class T>
+void ChunkedArray2D<T>::getTileCoords( int index, int & tile_row, int & tile_col ) const
+{
+	if( index < 0 || index >= m_num_tiles )
+		throw Exception( "ERROR: Tile out of bounds" );
+
+	tile_row = static_cast<int>( m_keys[index] >> 32 );
+	tile_col = static_cast<int>( m_keys[index] & 0xFFFFFFFF );
+}
+
+/***************************************************************
+*   Purpose: Makes the key a tile is stored under.
+*
+*     Entry: The row and column of the tile, neither negative.
+*
+*      Exit: Returns the key.
+****************************************************************/
+template<class T>
+long long ChunkedArray2D<T>::TileKey( int tile_row, int tile_col )
+{
+	return ( static_cast<long long>( tile_row ) << 32 ) | static_cast<long long>( tile_col );
+}
+
+/***************************************************************
+*   Purpose: Sets the total columns and rows to 0.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+template<class T>
+ChunkedArray2D<T>::~ChunkedArray2D()
+{
+	m_row = 0;
+	m_col = 0;
+}
+
+#endif
@@ -0,0 +1,759 @@
+/************************************************************************
+* CLASS: FixedBoard
+*
+* CONSTRUCTORS:
+*	FixedBoard()
+*		Default constructor for FixedBoard. Every Cell is covered and
+*		there are no bombs yet.
+*
+* METHODS:
+*	void Reset()
+*		Turns the FixedBoard back into a new, empty board.
+*	void Reset( int rows, int cols, int bombs )
+*		Same as Reset(). The size passed in must be the FixedBoard's own;
+*		it is only taken so that code written for Board can use either.
+*	static int GetRows()
+*		Returns ROWS.
+*	static int GetCols()
+*		Returns COLS.
+*	static int GetBombs()
+*		Returns BOMBS.
+*	const Cell & GetCell( int row, int col ) const
+*		Returns the Cell at the given row and column. Nothing is checked.
+*	CellGrid GetGrid() const
+*		Returns a read-only view of every Cell for the Solver and
+*		MineProbability.
+*	void PlaceBombs( unsigned long long seed )
+*	void PlaceBombs( unsigned long long seed, int safe_row, int safe_col )
+*		Places the bombs exactly where Board::PlaceBombs() would put them
+*		for the same seed, and sets the numbers.
+*	unsigned long long GetSeed() const
+*		Returns the seed that the bombs were placed with.
+*	bool ProcessCells( const char r, const char c, char action )
+*		Uncovers, chords or toggles the flag of a Cell given by the characters
+*		typed at the prompts, the same as Board::ProcessCells().
+*	bool ProcessCell( int row, int col, char action )
+*		Same as ProcessCells(), with the row and column as numbers.
+*	int CascadeCells( int row, int col )
+*		Uncovers the Cell and, if it is blank, the area around it.
+*		Returns how many Cells it uncovered.
+*	void UncoverAllCells()
+*		Uncovers every Cell, for when the game is lost.
+*	int GetNumCovered() const
+*	int GetNumFlags() const
+*	int GetNumRevealed() const
+*	bool IsWon() const
+*	bool IsLost() const
+*		The same counts and states as Board's.
+*	void TrackChanges( bool track )
+*	const std::vector<int> & GetChangedCells() const
+*	void ClearChangedCells()
+*		The same list of changed Cells as Board keeps.
+*	~FixedBoard()
+*		Destructs the object.
+*
+* FUNCTIONS:
+*	template< class Game > bool DispatchFixedBoard( int rows, int cols,
+*		int bombs, Game && game )
+*		Calls game with a FixedBoard of the given size if it is one of
+*		the presets from the main menu. Returns false if it is not, so
+*		that the caller can use a Board instead.
+*
+* NOTES:
+*	A FixedBoard plays the same game as a Board, Cell for Cell, but its
+*	size is known when it is compiled. The Cells live in a std::array
+*	inside the object, with no heap memory and no runtime dimensions.
+*	A border of uncovered, bomb-free Cells runs all the way round, so
+*	the eight neighbours of every Cell on the board are always at the
+*	same constant offsets in NEIGHBOURS and need no bounds checks. The
+*	loops over them have a fixed length the compiler can unroll.
+*
+*	The order that a cascade uncovers Cells in, and so the order of the
+*	changed Cells, is the same as Board's, so a Solver playing on either
+*	makes the same moves.
+*************************************************************************/
+#ifndef FIXEDBOARD_H
+#define FIXEDBOARD_H
+
+#include <array>
+#include <cctype>
+#include <iostream>
+#include <vector>
+#include "Cell.h"
+#include "CellGrid.h"
+#include "Exception.h"
+#include "Random.h"
+
+template< int ROWS, int COLS, int BOMBS >
+class FixedBoard
+{
+	static_assert( ROWS > 0 && COLS > 0, "A FixedBoard needs at least one Cell" );
+	static_assert( BOMBS >= 0 && BOMBS < ROWS * COLS, "A FixedBoard needs a safe Cell" );
+
+	public:
+		FixedBoard();
+		void Reset();
+		void Reset( int rows, int cols, int bombs );
+		static int GetRows();
+		static int GetCols();
+		static int GetBombs();
+		const Cell & GetCell( int row, int col ) const;
+		CellGrid GetGrid() const;
+		void PlaceBombs( unsigned long long seed );
+		void PlaceBombs( unsigned long long seed, int safe_row, int safe_col );
+		unsigned long long GetSeed() const;
+		bool ProcessCells( const char r, const char c, char action );
+		bool ProcessCell( int row, int col, char action );
+		int  CascadeCells( int row, int col );
+		void UncoverAllCells();
+		int  GetNumCovered() const;
+		int  GetNumFlags() const;
+		int  GetNumRevealed() const;
+		bool IsWon() const;
+		bool IsLost() const;
+		void TrackChanges( bool track );
+		const std::vector<int> & GetChangedCells() const;
+		void ClearChangedCells();
+		~FixedBoard();
+
+	private:
+		static const int WIDTH = COLS + 2;              // A row with its border
+		static const int SIZE = ( ROWS + 2 ) * WIDTH;   // Every Cell with the border
+		static const int FIRST = WIDTH + 1;             // Row 0, column 0
+
+		// Offsets of the eight neighbours, in the order Board visits them
+		static constexpr int NEIGHBOURS[8] = { -WIDTH - 1, -WIDTH, -WIDTH + 1, -1,
+											   1, WIDTH - 1, WIDTH, WIDTH + 1 };
+
+		static int Inside( int index );
+		static int ConvertCoords( char x );
+		bool ChordCell( int row, int col );
+		void RevealCell( Cell & cell, int index );
+
+		std::array<Cell, SIZE> m_cells;
+		std::array<int, ROWS * COLS> m_cascade; // Work stack; a Cell is pushed once at most
+		unsigned long long m_seed;
+		int  m_num_covered;
+		int  m_num_flags;
+		int  m_num_revealed;
+		bool m_lost;
+		bool m_track_changes;
+		std::vector<int> m_changes; // Indexes without the border, as on a Board
+};
+
+template< int ROWS, int COLS, int BOMBS >
+constexpr int FixedBoard<ROWS, COLS, BOMBS>::NEIGHBOURS[8];
+
+/***************************************************************
+*   Purpose: Default constructor for FixedBoard.
+*
+*     Entry: None
+*
+*      Exit: Every Cell is covered and there are no bombs yet.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+FixedBoard<ROWS, COLS, BOMBS>::FixedBoard() : m_seed( 0 ), m_track_changes( false )
+{
+	Reset();
+}
+
+/***************************************************************
+*   Purpose: Turns the FixedBoard back into a new, empty board so
+*			 that one object can be used for game after game.
+*
+*     Entry: None
+*
+*      Exit: Every Cell is covered and the border is uncovered.
+*			 The list of changed Cells is emptied.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::Reset()
+{
+	m_cells.fill( Cell() );
+
+	for( int c = 0; c < WIDTH; ++c )
+	{
+		m_cells[c].Uncover();
+		m_cells[SIZE - WIDTH + c].Uncover();
+	}
+
+	for( int r = 1; r <= ROWS; ++r )
+	{
+		m_cells[r * WIDTH].Uncover();
+		m_cells[( r * WIDTH ) + WIDTH - 1].Uncover();
+	}
+
+	m_seed = 0;
+	m_num_covered = ROWS * COLS;
+	m_num_flags = 0;
+	m_num_revealed = 0;
+	m_lost = false;
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Same as Reset(), for code written for Board.
+*
+*     Entry: The size, which must be the FixedBoard's own.
+*
+*      Exit: None
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::Reset( int, int, int )
+{
+	Reset();
+}
+
+/***************************************************************
+*   Purpose: Returns the number of rows.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::GetRows()
+{
+	return ROWS;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of columns.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::GetCols()
+{
+	return COLS;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of bombs.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::GetBombs()
+{
+	return BOMBS;
+}
+
+/***************************************************************
+*   Purpose: Returns the Cell at the given row and column.
+*
+*     Entry: A row and column on the board.
+*
+*      Exit: Returns the Cell.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+const Cell & FixedBoard<ROWS, COLS, BOMBS>::GetCell( int row, int col ) const
+{
+	return m_cells[FIRST + ( row * WIDTH ) + col];
+}
+
+/***************************************************************
+*   Purpose: Gets a read-only view of every Cell. The border is
+*			 stepped over by the grid's stride.
+*
+*     Entry: None
+*
+*      Exit: Returns the view.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+CellGrid FixedBoard<ROWS, COLS, BOMBS>::GetGrid() const
+{
+	return CellGrid( &m_cells[FIRST], ROWS, COLS, WIDTH, BOMBS );
+}
+
+/***************************************************************
+*   Purpose: Places the bombs with nothing kept clear. See the
+*			 other PlaceBombs().
+*
+*     Entry: No bombs are on the board. The seed for the generator.
+*
+*      Exit: Bombs are placed and the numbers are set.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::PlaceBombs( unsigned long long seed )
+{
+	PlaceBombs( seed, -1, -1 );
+}
+
+/***************************************************************
+*   Purpose: Places the bombs with the same Floyd sampling as
+*			 Board::PlaceBombs(), drawing the same numbers from the
+*			 same generator, so the same seed gives the same board.
+*			 The numbers are then counted by adding one around each
+*			 bomb through the eight constant neighbour offsets.
+*
+*     Entry: No bombs are on the board. The seed and the Cell whose
+*			 3x3 block is kept clear, or -1 for the row to keep
+*			 nothing clear.
+*
+*      Exit: Bombs are placed and the numbers are set.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::PlaceBombs( unsigned long long seed, int safe_row, int safe_col )
+{
+	Random generator( seed );
+	int clear[9];
+	int num_clear = 0;
+	std::array<int, BOMBS> bombs;
+
+	m_seed = seed;
+
+	if( safe_row >= 0 )
+	{
+		for( int r = safe_row - 1; r <= safe_row + 1; ++r )
+			for( int c = safe_col - 1; c <= safe_col + 1; ++c )
+				if( r >= 0 && r < ROWS && c >= 0 && c < COLS )
+					clear[num_clear++] = ( r * COLS ) + c;
+	}
+
+	const int num_cells = ( ROWS * COLS ) - num_clear;
+
+	try
+	{
+		if( BOMBS > num_cells )
+			throw Exception( "ERROR: More bombs than cells on the board" );
+	}
+	catch( Exception Error )
+	{
+		std::cout << Error << std::endl;
+		return;
+	}
+
+	for( int i = num_cells - BOMBS; i < num_cells; ++i )
+	{
+		int chosen = static_cast<int>( generator.NextBelow( i + 1 ) );
+		int index = chosen;
+
+		for( int j = 0; j < num_clear; ++j )
+			if( clear[j] <= index )
+				index++;
+
+		if( m_cells[Inside( index )].IsBomb() )
+		{
+			index = i;
+
+			for( int j = 0; j < num_clear; ++j )
+				if( clear[j] <= index )
+					index++;
+		}
+
+		bombs[i - ( num_cells - BOMBS )] = Inside( index );
+		m_cells[bombs[i - ( num_cells - BOMBS )]].SetBomb();
+	}
+
+	// Only the neighbours of a bomb get a number, and the border
+	// soaks up the counts that fall off the edge. A bomb keeps 0,
+	// the same as on a Board.
+	std::array<unsigned char, SIZE> counts = {};
+
+	for( int b = 0; b < BOMBS; ++b )
+		for( int n = 0; n < 8; ++n )
+			counts[bombs[b] + NEIGHBOURS[n]]++;
+
+	for( int b = 0; b < BOMBS; ++b )
+		counts[bombs[b]] = 0;
+
+	// The Cells are covered with no number yet, so the count can be
+	// or'd straight into each one's byte
+	unsigned char * cells = reinterpret_cast<unsigned char *>( m_cells.data() );
+
+	for( int r = 0; r < ROWS; ++r )
+	{
+		const int start = FIRST + ( r * WIDTH );
+
+		for( int c = 0; c < COLS; ++c )
+			cells[start + c] |= counts[start + c];
+	}
+}
+
+/***************************************************************
+*   Purpose: Returns the seed that the bombs were placed with.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+unsigned long long FixedBoard<ROWS, COLS, BOMBS>::GetSeed() const
+{
+	return m_seed;
+}
+
+/***************************************************************
+*   Purpose: Uncovers or flags the Cell given by the characters
+*			 typed at the prompts.
+*
+*     Entry: The row and column characters and the action.
+*
+*      Exit: The same as ProcessCell().
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+bool FixedBoard<ROWS, COLS, BOMBS>::ProcessCells( const char r, const char c, char action )
+{
+	return ProcessCell( ConvertCoords( static_cast<char>( toupper( r ) ) ),
+						ConvertCoords( static_cast<char>( toupper( c ) ) ), action );
+}
+
+/***************************************************************
+*   Purpose: Uncovers the Cell, with a cascade if it is blank,
+*			 chords it or toggles its flag, the same as
+*			 Board::ProcessCell().
+*
+*     Entry: The row and column of the Cell and the action, 'U' to
+*			 uncover, 'C' to chord and anything else to toggle the
+*			 flag.
+*
+*      Exit: Returns true if a bomb was uncovered, and
+*			 every Cell is uncovered then. A Cell that is not on the
+*			 board is reported and ignored.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+bool FixedBoard<ROWS, COLS, BOMBS>::ProcessCell( int row, int col, char action )
+{
+	try
+	{
+		if( row < 0 || row >= ROWS || col < 0 || col >= COLS )
+			throw Exception( "ERROR: Cell out of bounds" );
+	}
+	catch( Exception Error )
+	{
+		std::cout << Error << std::endl;
+		return false;
+	}
+
+	Cell & cell = m_cells[FIRST + ( row * WIDTH ) + col];
+
+	if( toupper( action ) == 'C' )
+	{
+		const bool loss = ChordCell( row, col );
+
+		if( loss )
+			UncoverAllCells();
+
+		return loss;
+	}
+
+	if( toupper( action ) == 'U' )
+		CascadeCells( row, col );
+	else
+	{
+		if( cell.IsFlagged() )
+		{
+			cell.SetFlag( 'F' );
+
+			if( cell.IsCovered() )
+				m_num_flags--;
+		}
+		else
+		{
+			cell.SetFlag( 'T' );
+
+			if( cell.IsCovered() )
+				m_num_flags++;
+		}
+
+		if( m_track_changes )
+			m_changes.push_back( ( row * COLS ) + col );
+	}
+
+	const bool loss = cell.IsBomb() && cell.IsCovered() == false;
+
+	if( loss )
+		UncoverAllCells();
+
+	return loss;
+}
+
+/***************************************************************
+*   Purpose: Chords a Cell the same as Board: if it is an
+*			 uncovered number and as many of its neighbours are
+*			 flagged, every other covered neighbour is uncovered.
+*			 The border is never covered, so it is skipped without
+*			 checking bounds.
+*
+*     Entry: The row and column of a Cell on the board.
+*
+*      Exit: Returns true if a bomb was uncovered.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+bool FixedBoard<ROWS, COLS, BOMBS>::ChordCell( int row, int col )
+{
+	const int centre = FIRST + ( row * WIDTH ) + col;
+	const int number = m_cells[centre].GetNumBombs();
+	int flags = 0;
+	bool loss = false;
+
+	if( m_cells[centre].IsCovered() || m_cells[centre].IsBomb() || number == 0 )
+		return false;
+
+	for( int n = 0; n < 8; ++n )
+		if( m_cells[centre + NEIGHBOURS[n]].IsCovered() && m_cells[centre + NEIGHBOURS[n]].IsFlagged() )
+			flags++;
+
+	if( flags != number )
+		return false;
+
+	for( int n = 0; n < 8; ++n )
+	{
+		const int neighbour = centre + NEIGHBOURS[n];
+
+		if( m_cells[neighbour].IsCovered() && m_cells[neighbour].IsFlagged() == false )
+		{
+			loss = loss || m_cells[neighbour].IsBomb();
+			CascadeCells( ( neighbour / WIDTH ) - 1, ( neighbour % WIDTH ) - 1 );
+		}
+	}
+
+	return loss;
+}
+
+/***************************************************************
+*   Purpose: Uncovers the Cell and, if it is blank, every blank
+*			 Cell joined to it and their numbered edges. The fill
+*			 uses a fixed-size stack and never checks bounds: the
+*			 border Cells are uncovered, so they are never pushed.
+*
+*     Entry: The row and column of a Cell on the board.
+*
+*      Exit: Returns the number of Cells that were uncovered.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::CascadeCells( int row, int col )
+{
+	const int first = FIRST + ( row * WIDTH ) + col;
+	Cell & start = m_cells[first];
+	int revealed = 0;
+	int top = 0;
+
+	if( start.IsCovered() == false )
+		return 0;
+
+	RevealCell( start, first );
+	revealed++;
+
+	if( start.IsBomb() || start.GetNumBombs() > 0 )
+		return revealed;
+
+	m_cascade[top++] = first;
+
+	while( top > 0 )
+	{
+		const int index = m_cascade[--top];
+
+		for( int n = 0; n < 8; ++n )
+		{
+			const int neighbour = index + NEIGHBOURS[n];
+			Cell & cell = m_cells[neighbour];
+
+			if( cell.IsCovered() )
+			{
+				RevealCell( cell, neighbour );
+				revealed++;
+
+				if( cell.GetNumBombs() == 0 )
+					m_cascade[top++] = neighbour;
+			}
+		}
+	}
+
+	return revealed;
+}
+
+/***************************************************************
+*   Purpose: Uncovers every Cell, for when the game is lost.
+*
+*     Entry: None
+*
+*      Exit: Nothing is covered or flagged. The list of changed
+*			 Cells is emptied, the same as on a Board.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::UncoverAllCells()
+{
+	for( Cell & cell : m_cells )
+		cell.Uncover();
+
+	m_num_covered = 0;
+	m_num_flags = 0;
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Returns the number of covered Cells, flagged or not.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::GetNumCovered() const
+{
+	return m_num_covered;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of covered Cells that are flagged.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::GetNumFlags() const
+{
+	return m_num_flags;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of safe Cells that are uncovered.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::GetNumRevealed() const
+{
+	return m_num_revealed;
+}
+
+/***************************************************************
+*   Purpose: Returns true once every safe Cell is uncovered.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+bool FixedBoard<ROWS, COLS, BOMBS>::IsWon() const
+{
+	return m_lost == false && m_num_revealed == ( ROWS * COLS ) - BOMBS;
+}
+
+/***************************************************************
+*   Purpose: Returns true once a bomb has been uncovered.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+bool FixedBoard<ROWS, COLS, BOMBS>::IsLost() const
+{
+	return m_lost;
+}
+
+/***************************************************************
+*   Purpose: Turns the recording of changed Cells on or off.
+*
+*     Entry: True to record changes.
+*
+*      Exit: The list of changed Cells is emptied.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::TrackChanges( bool track )
+{
+	m_track_changes = track;
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Returns the Cells, as row * COLS + column, that were
+*			 uncovered or had their flag toggled since the list was
+*			 last cleared.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+const std::vector<int> & FixedBoard<ROWS, COLS, BOMBS>::GetChangedCells() const
+{
+	return m_changes;
+}
+
+/***************************************************************
+*   Purpose: Empties the list of changed Cells.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::ClearChangedCells()
+{
+	m_changes.clear();
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+FixedBoard<ROWS, COLS, BOMBS>::~FixedBoard()
+{ }
+
+/***************************************************************
+*   Purpose: Turns an index without the border, as Board uses,
+*			 into one into m_cells.
+*
+*     Entry: row * COLS + column.
+*
+*      Exit: Returns the index into m_cells.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::Inside( int index )
+{
+	return FIRST + ( ( index / COLS ) * WIDTH ) + ( index % COLS );
+}
+
+/***************************************************************
+*   Purpose: Converts a coordinate typed at the prompts into a
+*			 number, the same as Board::ConvertCoords().
+*
+*     Entry: The upper-case character.
+*
+*      Exit: Returns the row or column.
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+int FixedBoard<ROWS, COLS, BOMBS>::ConvertCoords( char x )
+{
+	if( isalpha( x ) )
+		return static_cast<int>( x ) - 65;
+
+	return static_cast<int>( x ) - 23;
+}
+
+/***************************************************************
+*   Purpose: Uncovers one Cell and keeps the counts and the list
+*			 of changed Cells up to date.
+*
+*     Entry: The Cell, which is covered, and its index in m_cells.
+*
+*      Exit: None
+****************************************************************/
+template< int ROWS, int COLS, int BOMBS >
+void FixedBoard<ROWS, COLS, BOMBS>::RevealCell( Cell & cell, int index )
+{
+	if( cell.IsFlagged() )
+		m_num_flags--;
+
+	cell.Uncover();
+	m_num_covered--;
+
+	if( cell.IsBomb() )
+		m_lost = true;
+	else
+		m_num_revealed++;
+
+	if( m_track_changes )
+		m_changes.push_back( ( ( index / WIDTH ) - 1 ) * COLS + ( index % WIDTH ) - 1 );
+}
+
+/***************************************************************
+*   Purpose: Hands a FixedBoard of the given size to game, if the
+*			 size is one of the presets from the main menu. The
+*			 board is made here, once, and game can play as many
+*			 games on it as it likes.
+*
+*     Entry: The size of the board and a callable that takes any
+*			 FixedBoard by reference.
+*
+*      Exit: Returns false, without calling game, if the size is
+*			 not a preset.
+****************************************************************/
+template< class Game >
+bool DispatchFixedBoard( int rows, int cols, int bombs, Game && game )
+{
+	if( rows == 10 && cols == 10 && bombs == 10 )
+	{
+		FixedBoard<10, 10, 10> board;
+
+		game( board );
+		return true;
+	}
+
+	if( rows == 16 && cols == 16 && bombs == 40 )
+	{
+		FixedBoard<16, 16, 40> board;
+
+		game( board );
+		return true;
+	}
+
+	if( rows == 16 && cols == 30 && bombs == 100 )
+	{
+		FixedBoard<16, 30, 100> board;
+
+		game( board );
+		return true;
+	}
+
+	return false;
+}
+
+#endif
@@ -0,0 +1,780 @@
+#if !defined( _WIN32 )
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include "Exception.h"
+#include "GameServer.h"
+
+using std::cout;
+using std::endl;
+
+// Most Cells a game on the server may have
+const int MAX_SERVER_CELLS = 1 << 16;
+
+// Longest request line, including the newline
+const size_t MAX_REQUEST = 4096;
+
+// Events taken from epoll at a time
+const int MAX_EVENTS = 256;
+
+// Bytes read from a socket at a time
+const int READ_SIZE = 4096;
+
+// Latency buckets: 64 one nanosecond wide, then 32 per power of two
+const int LATENCY_BUCKETS = 64 * 32;
+
+// A game being played over one connection
+struct GameServer::Connection
+{
+	int socket;
+	bool open;
+	bool playing;       // NEW has been sent
+	bool closing;       // Close once the output has been sent
+	bool writing;       // Waiting for the socket to be writable
+	Board board;
+	std::string input;  // Bytes read but not yet a whole line
+	std::string output; // Replies not yet sent
+	size_t sent;        // Bytes of output already sent
+};
+
+/***************************************************************
+*   Purpose: Default constructor for GameServer. Nothing is
+*			 listened on.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+GameServer::GameServer() : m_listener( -1 ), m_poll( -1 ), m_stop( false ),
+						   m_random( std::random_device()() ), m_open( 0 ), m_peak( 0 ),
+						   m_accepted( 0 ), m_requests( 0 ), m_max_latency( 0 ),
+						   m_latencies( LATENCY_BUCKETS, 0 ), m_seconds( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Starts listening for connections. An address made
+*			 only of digits is a TCP port on every interface; any
+*			 other address is the path of a Unix socket, which is
+*			 replaced if it is already there.
+*
+*     Entry: The address to listen on.
+*
+*      Exit: Returns false if the server cannot listen there.
+****************************************************************/
+bool GameServer::Listen( const char * address )
+{
+	try
+	{
+#if defined( _WIN32 )
+		throw Exception( "ERROR: The server needs epoll, which Windows does not have" );
+#else
+		const bool tcp = address[0] != '\0' && strspn( address, "0123456789" ) == strlen( address );
+		int result = -1;
+
+		m_poll = epoll_create1( EPOLL_CLOEXEC );
+
+		if( m_poll < 0 )
+			throw Exception( "ERROR: Could not create the event loop" );
+
+		if( tcp )
+		{
+			sockaddr_in local = sockaddr_in();
+			const int reuse = 1;
+
+			local.sin_family = AF_INET;
+			local.sin_addr.s_addr = htonl( INADDR_ANY );
+			local.sin_port = htons( static_cast<unsigned short>( atoi( address ) ) );
+
+			m_listener = socket( AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+
+			if( m_listener >= 0 )
+			{
+				setsockopt( m_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+				result = bind( m_listener, reinterpret_cast<sockaddr *>( &local ), sizeof( local ) );
+			}
+		}
+		else
+		{
+			sockaddr_un local = sockaddr_un();
+
+			if( strlen( address ) >= sizeof( local.sun_path ) )
+				throw Exception( "ERROR: The socket path is too long" );
+
+			local.sun_family = AF_UNIX;
+			strcpy( local.sun_path, address );
+			unlink( address );
+
+			m_listener = socket( AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+
+			if( m_listener >= 0 )
+			{
+				result = bind( m_listener, reinterpret_cast<sockaddr *>( &local ), sizeof( local ) );
+
+				if( result == 0 )
+					m_unix_path = address;
+			}
+		}
+
+		if( m_listener < 0 || result != 0 || listen( m_listener, SOMAXCONN ) != 0 )
+			throw Exception( "ERROR: Could not listen on the address" );
+
+		epoll_event event = epoll_event();
+
+		event.events = EPOLLIN;
+		event.data.fd = m_listener;
+
+		if( epoll_ctl( m_poll, EPOLL_CTL_ADD, m_listener, &event ) != 0 )
+			throw Exception( "ERROR: Could not create the event loop" );
+#endif
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Serves games on every connection until the time is
+*			 up or Stop() is called.
+*
+*     Entry: Listen() succeeded. How many seconds to serve for, or
+*			 0 to serve until Stop() is called.
+*
+*      Exit: Returns the statistics of the run. Connections stay
+*			 open, so Run() can be called again.
+****************************************************************/
+ServerStats GameServer::Run( double seconds )
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+#if !defined( _WIN32 )
+	epoll_event events[MAX_EVENTS];
+
+	while( m_poll >= 0 && m_stop == false )
+	{
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if( seconds > 0 && elapsed.count() >= seconds )
+			break;
+
+		// Wake up now and then to notice Stop() and the end of the run
+		const int ready = epoll_wait( m_poll, events, MAX_EVENTS, 100 );
+
+		for( int i = 0; i < ready; ++i )
+		{
+			const int socket = events[i].data.fd;
+
+			if( socket == m_listener )
+			{
+				Accept();
+				continue;
+			}
+
+			Connection & connection = *m_connections[socket];
+
+			// Nothing more can be sent to a client that has gone
+			if( events[i].events & ( EPOLLERR | EPOLLHUP ) )
+			{
+				Close( connection );
+				continue;
+			}
+
+			if( connection.writing )
+				Write( connection );
+			else
+				Read( connection );
+
+			if( connection.closing && connection.output.empty() )
+				Close( connection );
+		}
+	}
+#endif
+
+	m_seconds += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+	return GetStats();
+}
+
+/***************************************************************
+*   Purpose: Makes Run() return within a tenth of a second, and
+*			 any later Run() return at once. Can be called from any
+*			 thread.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void GameServer::Stop()
+{
+	m_stop = true;
+}
+
+/***************************************************************
+*   Purpose: Gets the connection counts and the latency
+*			 percentiles of every request so far.
+*
+*     Entry: None
+*
+*      Exit: Returns the statistics.
+****************************************************************/
+ServerStats GameServer::GetStats() const
+{
+	ServerStats stats = ServerStats();
+
+	stats.open = m_open;
+	stats.peak = m_peak;
+	stats.accepted = m_accepted;
+	stats.requests = m_requests;
+	stats.p50 = Percentile( 0.50 );
+	stats.p90 = Percentile( 0.90 );
+	stats.p99 = Percentile( 0.99 );
+	stats.max = m_max_latency / 1000.0;
+	stats.seconds = m_seconds;
+
+	return stats;
+}
+
+/***************************************************************
+*   Purpose: Prints the connection counts, the requests per
+*			 second and the latency percentiles of a run.
+*
+*     Entry: The statistics returned by Run().
+*
+*      Exit: The report is displayed to the console.
+****************************************************************/
+void GameServer::Report( const ServerStats & stats )
+{
+	double per_second = 0;
+
+	if( stats.seconds > 0 )
+		per_second = stats.requests / stats.seconds;
+
+	cout << "Connections:      " << stats.accepted << " accepted, " << stats.peak
+		 << " at most at once, " << stats.open << " still open\n"
+		 << "Requests:         " << stats.requests << '\n'
+		 << "Time:             " << stats.seconds << " seconds\n"
+		 << "Requests/second:  " << per_second << '\n'
+		 << "Latency (us):     p50 " << stats.p50 << ", p90 " << stats.p90
+		 << ", p99 " << stats.p99 << ", max " << stats.max << endl;
+}
+
+/***************************************************************
+*   Purpose: Accepts every connection that is waiting and starts
+*			 watching it for requests.
+*
+*     Entry: The listening socket is readable.
+*
+*      Exit: None
+****************************************************************/
+void GameServer::Accept()
+{
+#if !defined( _WIN32 )
+	int socket = accept4( m_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC );
+
+	while( socket >= 0 )
+	{
+		const int no_delay = 1;
+
+		// Fails harmlessly on a Unix socket
+		setsockopt( socket, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof( no_delay ) );
+
+		if( static_cast<size_t>( socket ) >= m_connections.size() )
+			m_connections.resize( socket + 1 );
+
+		if( m_connections[socket] == nullptr )
+			m_connections[socket].reset( new Connection() );
+
+		Connection & connection = *m_connections[socket];
+		epoll_event event = epoll_event();
+
+		connection.socket = socket;
+		connection.open = true;
+		connection.playing = false;
+		connection.closing = false;
+		connection.writing = false;
+		connection.input.clear();
+		connection.output.clear();
+		connection.sent = 0;
+		connection.board.TrackChanges( false );
+
+		event.events = EPOLLIN;
+		event.data.fd = socket;
+
+		if( epoll_ctl( m_poll, EPOLL_CTL_ADD, socket, &event ) != 0 )
+		{
+			close( socket );
+			connection.open = false;
+		}
+		else
+		{
+			m_accepted++;
+			m_open++;
+
+			if( m_open > m_peak )
+				m_peak = m_open;
+		}
+
+		socket = accept4( m_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC );
+	}
+#endif
+}
+
+/***************************************************************
+*   Purpose: Reads what the client has sent and handles every
+*			 whole line in it, then sends the replies.
+*
+*     Entry: The connection's socket is readable.
+*
+*      Exit: The connection is marked for closing if the client
+*			 has gone or sent a line that is too long.
+****************************************************************/
+void GameServer::Read( Connection & connection )
+{
+#if !defined( _WIN32 )
+	char buffer[READ_SIZE];
+	const ssize_t length = recv( connection.socket, buffer, sizeof( buffer ), 0 );
+
+	if( length <= 0 )
+	{
+		if( length == 0 || ( errno != EAGAIN && errno != EINTR ) )
+			connection.closing = true;
+
+		return;
+	}
+
+	connection.input.append( buffer, static_cast<size_t>( length ) );
+
+	size_t begin = 0;
+	size_t end = connection.input.find( '\n' );
+
+	while( end != std::string::npos && connection.closing == false )
+	{
+		connection.input[end] = '\0';
+		HandleRequest( connection, &connection.input[begin] );
+
+		begin = end + 1;
+		end = connection.input.find( '\n', begin );
+	}
+
+	connection.input.erase( 0, begin );
+
+	if( connection.input.size() >= MAX_REQUEST )
+	{
+		connection.output += "ERR Request too long\n";
+		connection.closing = true;
+	}
+
+	Write( connection );
+#endif
+}
+
+/***************************************************************
+*   Purpose: Sends as much of the waiting output as the socket
+*			 will take.
+*
+*     Entry: None
+*
+*      Exit: Whatever was sent is dropped from the output. The
+*			 connection is watched for being writable if some of
+*			 it is still waiting.
+****************************************************************/
+void GameServer::Write( Connection & connection )
+{
+#if !defined( _WIN32 )
+	while( connection.sent < connection.output.size() )
+	{
+		const ssize_t length = send( connection.socket, connection.output.data() + connection.sent,
+									 connection.output.size() - connection.sent, MSG_NOSIGNAL );
+
+		if( length < 0 )
+		{
+			if( errno == EINTR )
+				continue;
+
+			if( errno != EAGAIN )
+			{
+				connection.closing = true;
+				connection.output.clear();
+				connection.sent = 0;
+			}
+
+			break;
+		}
+
+		connection.sent += static_cast<size_t>( length );
+	}
+
+	if( connection.sent == connection.output.size() )
+	{
+		connection.output.clear();
+		connection.sent = 0;
+	}
+
+	Watch( connection );
+#endif
+}
+
+/***************************************************************
+*   Purpose: Watches the connection for being writable while it
+*			 has output waiting and for requests otherwise, so a
+*			 client that does not read its replies cannot make the
+*			 server hold more and more of them.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void GameServer::Watch( Connection & connection )
+{
+#if !defined( _WIN32 )
+	const bool writing = connection.output.empty() == false;
+
+	if( writing != connection.writing )
+	{
+		epoll_event event = epoll_event();
+
+		event.events = writing ? EPOLLOUT : EPOLLIN;
+		event.data.fd = connection.socket;
+		epoll_ctl( m_poll, EPOLL_CTL_MOD, connection.socket, &event );
+
+		connection.writing = writing;
+	}
+#endif
+}
+
+/***************************************************************
+*   Purpose: Closes the connection. Its Board is kept for the
+*			 next connection given the same socket number.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void GameServer::Close( Connection & connection )
+{
+#if !defined( _WIN32 )
+	epoll_ctl( m_poll, EPOLL_CTL_DEL, connection.socket, nullptr );
+	close( connection.socket );
+#endif
+
+	connection.open = false;
+	connection.input.clear();
+	connection.output.clear();
+	connection.sent = 0;
+	connection.closing = false;
+	connection.writing = false;
+	m_open--;
+}
+
+/***************************************************************
+*   Purpose: Carries out one request and appends its reply to the
+*			 connection's output.
+*
+*     Entry: The request line, without its newline. It is changed
+*			 while it is split into words.
+*
+*      Exit: None
+****************************************************************/
+void GameServer::HandleRequest( Connection & connection, char * line )
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	char command[16] = "";
+	int rows = 0;
+	int cols = 0;
+	int bombs = 0;
+	unsigned long long seed = 0;
+	const int count = sscanf( line, "%15s %d %d %d %llu", command, &rows, &cols, &bombs, &seed );
+
+	for( char * letter = command; *letter != '\0'; ++letter )
+		*letter = static_cast<char>( toupper( *letter ) );
+
+	if( count <= 0 )
+		connection.output += "ERR Empty request\n";
+	else if( strcmp( command, "NEW" ) == 0 )
+	{
+		if( count < 4 || rows <= 0 || cols <= 0 || rows > MAX_SERVER_CELLS / cols ||
+			bombs < 0 || bombs >= rows * cols )
+			connection.output += "ERR Invalid board size\n";
+		else
+		{
+			char reply[96];
+
+			if( count < 5 )
+				seed = m_random.Next();
+
+			connection.board.Reset( rows, cols, bombs );
+			connection.board.PlaceBombs( seed );
+			connection.board.LabelRegions();
+			connection.playing = true;
+
+			snprintf( reply, sizeof( reply ), "OK NEW %d %d %d %llu\n", rows, cols, bombs, seed );
+			connection.output += reply;
+		}
+	}
+	else if( strcmp( command, "REVEAL" ) == 0 || strcmp( command, "FLAG" ) == 0 ||
+			 strcmp( command, "CHORD" ) == 0 )
+	{
+		// The row and column were read into rows and cols
+		if( connection.playing == false )
+			connection.output += "ERR No game\n";
+		else if( connection.board.IsLost() || connection.board.IsWon() )
+			connection.output += "ERR Game over\n";
+		else if( count < 3 || rows < 0 || rows >= connection.board.GetRows() ||
+				 cols < 0 || cols >= connection.board.GetCols() )
+			connection.output += "ERR Cell out of bounds\n";
+		else
+		{
+			const BoardAction action = { rows, cols, command[0] == 'R' ? 'U' : command[0] };
+
+			m_actions.assign( 1, action );
+			Move( connection, m_actions );
+		}
+	}
+	else if( strcmp( command, "MOVES" ) == 0 )
+	{
+		if( connection.playing == false )
+			connection.output += "ERR No game\n";
+		else if( connection.board.IsLost() || connection.board.IsWon() )
+			connection.output += "ERR Game over\n";
+		else if( ReadMoves( connection.board, line + strspn( line, " \t" ) + strlen( command ) ) == false )
+			connection.output += "ERR Invalid moves\n";
+		else
+			Move( connection, m_actions );
+	}
+	else if( strcmp( command, "STATE" ) == 0 )
+	{
+		if( connection.playing == false )
+			connection.output += "ERR No game\n";
+		else
+			AppendState( connection );
+	}
+	else if( strcmp( command, "STATS" ) == 0 )
+	{
+		const ServerStats stats = GetStats();
+		char reply[160];
+
+		snprintf( reply, sizeof( reply ), "OK STATS %lld %lld %lld %lld %.3f %.3f %.3f %.3f\n",
+				  stats.open, stats.peak, stats.accepted, stats.requests,
+				  stats.p50, stats.p90, stats.p99, stats.max );
+		connection.output += reply;
+	}
+	else if( strcmp( command, "QUIT" ) == 0 )
+	{
+		connection.output += "OK BYE\n";
+		connection.closing = true;
+	}
+	else
+		connection.output += "ERR Unknown request\n";
+
+	m_requests++;
+	RecordLatency( std::chrono::duration_cast<std::chrono::nanoseconds>(
+				   std::chrono::steady_clock::now() - start ).count() );
+}
+
+/***************************************************************
+*   Purpose: Reads the moves of a MOVES request into m_actions.
+*
+*     Entry: The Board they are for and the text after the word
+*			 MOVES.
+*
+*      Exit: Returns false if there are no moves, or if one has a
+*			 letter other than R, F or C or a Cell that is not on
+*			 the Board.
+****************************************************************/
+bool GameServer::ReadMoves( const Board & board, const char * moves )
+{
+	char letter = '\0';
+	int row = 0;
+	int col = 0;
+	int used = 0;
+
+	m_actions.clear();
+
+	while( sscanf( moves, " %c %d %d%n", &letter, &row, &col, &used ) == 3 )
+	{
+		const char action = static_cast<char>( toupper( letter ) );
+
+		if( ( action != 'R' && action != 'F' && action != 'C' ) || row < 0 ||
+			row >= board.GetRows() || col < 0 || col >= board.GetCols() )
+			return false;
+
+		const BoardAction move = { row, col, action == 'R' ? 'U' : action };
+
+		m_actions.push_back( move );
+		moves += used;
+	}
+
+	// Anything left over is a move that could not be read
+	return m_actions.empty() == false && moves[strspn( moves, " \t\r" )] == '\0';
+}
+
+/***************************************************************
+*   Purpose: Carries out the moves of a request and replies with
+*			 the state of the game and only the Cells that
+*			 changed. A loss uncovers every Cell, so then every
+*			 Cell is sent.
+*
+*     Entry: A game is being played and every Cell is on the
+*			 Board. The actions are 'U', 'F' or 'C'.
+*
+*      Exit: None
+****************************************************************/
+void GameServer::Move( Connection & connection, const std::vector<BoardAction> & actions )
+{
+	Board & board = connection.board;
+	const int cols = board.GetCols();
+	char number[48];
+
+	board.ProcessActions( actions, m_changed );
+
+	if( board.IsLost() )
+	{
+		const int cells = board.GetRows() * cols;
+
+		snprintf( number, sizeof( number ), "OK LOST %d", cells );
+		connection.output += number;
+
+		for( int i = 0; i < cells; ++i )
+		{
+			snprintf( number, sizeof( number ), " %d %d %c", i / cols, i % cols,
+					  board.GetCell( i / cols, i % cols ).GetSymbol() );
+			connection.output += number;
+		}
+	}
+	else
+	{
+		snprintf( number, sizeof( number ), "OK %s %d", board.IsWon() ? "WON" : "PLAYING",
+				  static_cast<int>( m_changed.size() ) );
+		connection.output += number;
+
+		for( int index : m_changed )
+		{
+			snprintf( number, sizeof( number ), " %d %d %c", index / cols, index % cols,
+					  board.GetCell( index / cols, index % cols ).GetSymbol() );
+			connection.output += number;
+		}
+	}
+
+	connection.output += '\n';
+}
+
+/***************************************************************
+*   Purpose: Replies with the state of the game, its counts and
+*			 the symbol of every Cell in row order.
+*
+*     Entry: A game is being played.
+*
+*      Exit: None
+****************************************************************/
+void GameServer::AppendState( Connection & connection )
+{
+	const Board & board = connection.board;
+	const char * state = board.IsLost() ? "LOST" : ( board.IsWon() ? "WON" : "PLAYING" );
+	char header[96];
+
+	snprintf( header, sizeof( header ), "OK %s %d %d %d %d %d ", state, board.GetRows(),
+			  board.GetCols(), board.GetBombs(), board.GetNumCovered(), board.GetNumFlags() );
+	connection.output += header;
+
+	for( int r = 0; r < board.GetRows(); ++r )
+		for( int c = 0; c < board.GetCols(); ++c )
+			connection.output += board.GetCell( r, c ).GetSymbol();
+
+	connection.output += '\n';
+}
+
+/***************************************************************
+*   Purpose: Counts a request's latency in its bucket. Values
+*			 under 64ns get a bucket each; above that each power
+*			 of two is split into 32 buckets.
+*
+*     Entry: The latency in nanoseconds.
+*
+*      Exit: None
+****************************************************************/
+void GameServer::RecordLatency( long long nanoseconds )
+{
+	unsigned long long value = static_cast<unsigned long long>( nanoseconds < 0 ? 0 : nanoseconds );
+	int shift = 0;
+
+	if( nanoseconds > m_max_latency )
+		m_max_latency = nanoseconds;
+
+	while( value >= 64 )
+	{
+		value >>= 1;
+		shift++;
+	}
+
+	m_latencies[( shift * 32 ) + static_cast<int>( value )]++;
+}
+
+/***************************************************************
+*   Purpose: Finds the latency that the given fraction of the
+*			 requests were at or under.
+*
+*     Entry: The fraction, from 0 up to but not including 1.
+*
+*      Exit: Returns the lower edge of the bucket it falls in, in
+*			 microseconds, or 0 if there were no requests.
+****************************************************************/
+double GameServer::Percentile( double fraction ) const
+{
+	const long long wanted = static_cast<long long>( fraction * m_requests );
+	long long seen = 0;
+
+	for( int i = 0; i < LATENCY_BUCKETS; ++i )
+	{
+		seen += m_latencies[i];
+
+		if( seen > wanted )
+		{
+			const int shift = i < 64 ? 0 : ( i - 32 ) / 32;
+			const long long value = i - ( shift * 32 );
+
+			return ( value << shift ) / 1000.0;
+		}
+	}
+
+	return 0;
+}
+
+/***************************************************************
+*   Purpose: Closes every connection and the listening socket, and
+*			 removes the Unix socket file if there is one.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+GameServer::~GameServer()
+{
+#if !defined( _WIN32 )
+	for( std::unique_ptr<Connection> & connection : m_connections )
+		if( connection != nullptr && connection->open )
+			close( connection->socket );
+
+	if( m_listener >= 0 )
+		close( m_listener );
+
+	if( m_poll >= 0 )
+		close( m_poll );
+
+	if( m_unix_path.empty() == false )
+		unlink( m_unix_path.c_str() );
+#endif
+}
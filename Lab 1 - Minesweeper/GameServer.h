@@ -0,0 +1,140 @@
+/************************************************************************
+* CLASS: GameServer
+*
+* CONSTRUCTORS:
+*	GameServer()
+*		Default constructor for GameServer. Nothing is listened on.
+*
+* METHODS:
+*	bool Listen( const char * address )
+*		Starts listening on a TCP port, if the address is a number, or on
+*		a Unix socket at the path given. Returns false if it cannot.
+*	ServerStats Run( double seconds )
+*		Serves games until the time is up (0 means until Stop() is
+*		called) and returns the statistics of the run.
+*	void Stop()
+*		Makes Run() return, now and from then on. Can be called from any
+*		thread.
+*	ServerStats GetStats() const
+*		Gets the connection counts and request latencies so far.
+*	static void Report( const ServerStats & stats )
+*		Prints the connection counts and latency percentiles of a run.
+*	~GameServer()
+*		Closes every connection and the listening socket.
+*
+* PROTOCOL:
+*	Every request and every reply is one line of text. Rows and columns
+*	start at 0, and a Cell is shown by its symbol from Cell::GetSymbol().
+*
+*		NEW <rows> <cols> <bombs> [seed]
+*			-> OK NEW <rows> <cols> <bombs> <seed>
+*		REVEAL <row> <col>
+*		FLAG <row> <col>
+*		CHORD <row> <col>
+*			-> OK <PLAYING|WON|LOST> <n> <row> <col> <symbol> ...
+*			   with only the n Cells that changed.
+*		MOVES <R|F|C> <row> <col> [<R|F|C> <row> <col> ...]
+*			-> The same as REVEAL, for every move at once. The moves are
+*			   carried out in order by Board::ProcessActions(), stopping
+*			   at a bomb.
+*		STATE
+*			-> OK <PLAYING|WON|LOST> <rows> <cols> <bombs> <covered>
+*			   <flags> <symbols>, with every Cell in row order.
+*		STATS
+*			-> OK STATS <open> <peak> <accepted> <requests> <p50> <p90>
+*			   <p99> <max>, with the latencies in microseconds.
+*		QUIT
+*			-> OK BYE, and the connection is closed.
+*
+*	A request that cannot be carried out gets ERR and a message.
+*
+* NOTES:
+*	One thread serves every connection with an epoll loop, so thousands
+*	of games can be played at once. Each connection owns a Board and its
+*	sockets never block: requests are handled as soon as a whole line has
+*	arrived and replies that do not fit in the socket wait until it is
+*	writable, with no more requests read from that connection until then.
+*
+*	The blank regions of each game are labelled when it starts (see
+*	Board::LabelRegions()), so the time a move takes depends only on how
+*	many Cells it uncovers, not on the shape of the area it opens.
+*
+*	A request line can be up to 4 KB long, which is room for a few
+*	hundred moves.
+*
+*	The latency of a request is the time from its line being read to its
+*	reply being ready. Latencies are counted in buckets that are 1/32 of
+*	a power of two wide, so the percentiles are within about 3%.
+*
+*	The server needs epoll, so on Windows Listen() always fails.
+*************************************************************************/
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Random.h"
+
+struct ServerStats
+{
+	long long open;     // Connections open now
+	long long peak;     // Most connections open at once
+	long long accepted; // Connections accepted in all
+	long long requests;
+	double    p50;      // Latency percentiles in microseconds
+	double    p90;
+	double    p99;
+	double    max;
+	double    seconds;
+};
+
+class GameServer
+{
+	public:
+		GameServer();
+		bool Listen( const char * address );
+		ServerStats Run( double seconds );
+		void Stop();
+		ServerStats GetStats() const;
+		static void Report( const ServerStats & stats );
+		~GameServer();
+
+	private:
+		struct Connection;
+
+		GameServer( const GameServer & copy );
+		GameServer & operator=( const GameServer & rhs );
+
+		void Accept();
+		void Read( Connection & connection );
+		void Write( Connection & connection );
+		void Watch( Connection & connection );
+		void Close( Connection & connection );
+		void HandleRequest( Connection & connection, char * line );
+		bool ReadMoves( const Board & board, const char * moves );
+		void Move( Connection & connection, const std::vector<BoardAction> & actions );
+		void AppendState( Connection & connection );
+		void RecordLatency( long long nanoseconds );
+		double Percentile( double fraction ) const;
+
+		int m_listener;
+		int m_poll;
+		std::string m_unix_path; // Socket file to remove, if listening on one
+		std::vector<std::unique_ptr<Connection>> m_connections; // By socket
+		std::atomic<bool> m_stop;
+		Random m_random; // Seeds for games started without one
+		long long m_open;
+		long long m_peak;
+		long long m_accepted;
+		long long m_requests;
+		long long m_max_latency;
+		std::vector<long long> m_latencies; // Requests in each latency bucket
+		std::vector<BoardAction> m_actions; // Moves of the request being handled
+		std::vector<int> m_changed;         // Cells changed by those moves
+		double m_seconds;
+};
+
+#endif
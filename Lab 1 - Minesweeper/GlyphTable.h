@@ -0,0 +1,89 @@
+/************************************************************************
+* CLASS: GlyphTable
+*
+* CONSTRUCTORS:
+*	GlyphTable()
+*		Works out what is drawn for every Cell state.
+*
+* METHODS:
+*	const Glyph & operator[]( unsigned char state ) const
+*		Gets what is drawn for a Cell, given its state byte.
+*
+* NOTES:
+*	This is the one place that says which symbol and colour each Cell
+*	is drawn in: Cell::Display(), the Renderer and the Viewport all look
+*	them up here, so the three cannot drift apart. The symbols are the
+*	ones from Cell::GetSymbol(). Uncovered bombs are red, uncovered
+*	numbers green, uncovered blanks blue, flags yellow and covered Cells
+*	the default colour.
+*************************************************************************/
+#ifndef GLYPHTABLE_H
+#define GLYPHTABLE_H
+
+#include "Cell.h"
+#include "Terminal.h"
+
+// What is drawn for one Cell state
+struct Glyph
+{
+	char symbol;
+	unsigned char color;   // A Terminal::Color
+	bool covered;          // Flagged Cells count as covered
+};
+
+class GlyphTable
+{
+	public:
+		GlyphTable();
+		const Glyph & operator[]( unsigned char state ) const;
+
+	private:
+		Glyph m_glyphs[256];   // Indexed by the Cell's state byte
+};
+
+/***************************************************************
+*   Purpose: Works out the symbol, colour and covered state that
+*			 are drawn for every Cell state.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+inline GlyphTable::GlyphTable()
+{
+	for( int state = 0; state < 256; state++ )
+	{
+		Cell cell;
+
+		reinterpret_cast<unsigned char &>( cell ) = static_cast<unsigned char>( state );
+
+		Glyph & glyph = m_glyphs[state];
+
+		glyph.symbol = cell.GetSymbol();
+		glyph.color = Terminal::DEFAULT;
+		glyph.covered = cell.IsCovered();
+
+		if( glyph.symbol == 'X' )
+			glyph.color = Terminal::RED;
+		else if( glyph.symbol == 'F' )
+			glyph.color = Terminal::YELLOW;
+		else if( glyph.symbol == '.' )
+			glyph.color = Terminal::BLUE;
+		else if( glyph.symbol >= '1' && glyph.symbol <= '8' )
+			glyph.color = Terminal::GREEN;
+	}
+}
+
+/***************************************************************
+*   Purpose: Gets what is drawn for a Cell.
+*
+*     Entry: The Cell's state byte.
+*
+*      Exit: Returns its Glyph.
+****************************************************************/
+inline const Glyph & GlyphTable::operator[]( unsigned char state ) const
+{
+	return m_glyphs[state];
+}
+
+#endif
@@ -0,0 +1,324 @@
+#include <cstring>
+#include <iostream>
+#include "Exception.h"
+#include "Journal.h"
+#include "MappedFile.h"
+
+using std::cout;
+using std::endl;
+
+// The start of a journal file
+struct JournalHeader
+{
+	char magic[4];
+	unsigned int version;
+	unsigned int chunked;
+	int rows;
+	int cols;
+	int bombs;
+	unsigned long long seed;
+	int safe_row;
+	int safe_col;
+	char unused[24];
+};
+
+// One action, or the final state when action is 'E'
+struct JournalEntry
+{
+	int row;            // 'E': covered Cells
+	int col;            // 'E': flagged Cells
+	unsigned int value; // Milliseconds since the first action, 'E': checksum
+	char action;        // 'U', 'F', 'C' or 'E'
+	char lost;          // 'E': 1 if the game was lost
+	char unused[2];
+};
+
+static_assert( sizeof( JournalHeader ) == 64, "The journal header must stay 64 bytes" );
+static_assert( sizeof( JournalEntry ) == 16, "A journal entry must stay 16 bytes" );
+
+const char JOURNAL_MAGIC[4] = { 'M', 'S', 'W', 'J' };
+const unsigned int JOURNAL_VERSION = 1;
+
+/***************************************************************
+*   Purpose: Default constructor for Journal. No file is open.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Journal::Journal() : m_started( false )
+{ }
+
+/***************************************************************
+*   Purpose: Creates the journal file. Nothing is written until
+*			 the first action is recorded.
+*
+*     Entry: The path of the file, which is replaced if it exists.
+*
+*      Exit: Returns false if the file could not be created.
+****************************************************************/
+bool Journal::Open( const char * path )
+{
+	Close();
+
+	try
+	{
+		m_file.open( path, std::ios::binary | std::ios::trunc );
+
+		if( m_file.is_open() == false )
+			throw Exception( "ERROR: Could not create the journal file" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	m_started = false;
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Appends an action to the journal. The first action
+*			 writes the header first, since that is when the bombs
+*			 are known to be placed.
+*
+*     Entry: The Board the action is for and the action, exactly
+*			 as ProcessCell() was given it.
+*
+*      Exit: The entry is flushed to the file.
+****************************************************************/
+void Journal::Record( const Board & board, int row, int col, char action )
+{
+	if( m_file.is_open() == false )
+		return;
+
+	if( m_started == false )
+		WriteHeader( board );
+
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+
+	WriteEntry( row, col, static_cast<unsigned int>( elapsed.count() ), action, 0 );
+}
+
+/***************************************************************
+*   Purpose: Appends the final state of the Board, for Replay()
+*			 to check, and closes the file.
+*
+*     Entry: The Board once the game is over.
+*
+*      Exit: The file is closed.
+****************************************************************/
+void Journal::Finish( const Board & board )
+{
+	if( m_file.is_open() == false )
+		return;
+
+	if( m_started == false )
+		WriteHeader( board );
+
+	WriteEntry( board.GetNumCovered(), board.GetNumFlags(), board.GetChecksum(), 'E',
+				board.IsLost() ? 1 : 0 );
+	Close();
+}
+
+/***************************************************************
+*   Purpose: Closes the file without a final state.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void Journal::Close()
+{
+	if( m_file.is_open() )
+		m_file.close();
+
+	m_file.clear();
+	m_started = false;
+}
+
+/***************************************************************
+*   Purpose: Tells whether a file is open.
+*
+*     Entry: None
+*
+*      Exit: Returns true if one is.
+****************************************************************/
+bool Journal::IsOpen() const
+{
+	return m_file.is_open();
+}
+
+/***************************************************************
+*   Purpose: Sets up the Board from a journal and plays every
+*			 action in it, as fast as it can and without any
+*			 console prompts. The file is memory mapped and read
+*			 straight from the mapping. If the journal has a final
+*			 state, the replayed Board is checked against it.
+*
+*     Entry: The path of the journal, the Board to play on, which
+*			 must not be recording a journal, and where to store
+*			 the results.
+*
+*      Exit: Returns false if the file is not a journal. Otherwise
+*			 the Board is left in its final state.
+****************************************************************/
+bool Journal::Replay( const char * path, Board & board, ReplayResults & results )
+{
+	MappedFile file;
+	JournalHeader header;
+
+	results = ReplayResults();
+
+	try
+	{
+		file.Open( path );
+
+		if( file.size() < sizeof( header ) )
+			throw Exception( "ERROR: The file is not a journal" );
+
+		memcpy( &header, file.data(), sizeof( header ) );
+
+		if( memcmp( header.magic, JOURNAL_MAGIC, sizeof( header.magic ) ) != 0 )
+			throw Exception( "ERROR: The file is not a journal" );
+
+		if( header.version != JOURNAL_VERSION )
+			throw Exception( "ERROR: The journal was written by a different version" );
+
+		if( header.rows < 0 || header.cols < 0 )
+			throw Exception( "ERROR: The journal is damaged" );
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	const JournalEntry * entries = reinterpret_cast<const JournalEntry *>( file.data() + sizeof( header ) );
+	const long long num_entries = static_cast<long long>( ( file.size() - sizeof( header ) ) /
+														  sizeof( JournalEntry ) );
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if( header.chunked )
+		board.ResetChunked( header.rows, header.cols, header.bombs );
+	else
+		board.Reset( header.rows, header.cols, header.bombs );
+
+	board.PlaceBombs( header.seed, header.safe_row, header.safe_col );
+
+	for( long long i = 0; i < num_entries; ++i )
+	{
+		const JournalEntry & entry = entries[i];
+
+		if( entry.action == 'E' )
+		{
+			results.finished = true;
+			results.matched = ( board.GetNumCovered() == entry.row &&
+								board.GetNumFlags() == entry.col &&
+								board.IsLost() == ( entry.lost != 0 ) &&
+								board.GetChecksum() == entry.value );
+			break;
+		}
+
+		board.ProcessCell( entry.row, entry.col, entry.action );
+		results.moves++;
+	}
+
+	results.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Prints the number of moves replayed, how fast they
+*			 went and whether the final state matched.
+*
+*     Entry: The results returned by Replay().
+*
+*      Exit: The report is displayed to the console.
+****************************************************************/
+void Journal::Report( const ReplayResults & results )
+{
+	double per_second = 0;
+
+	if( results.seconds > 0 )
+		per_second = results.moves / results.seconds;
+
+	cout << "Moves replayed:   " << results.moves << '\n'
+		 << "Time:             " << results.seconds << " seconds\n"
+		 << "Moves/second:     " << per_second << '\n'
+		 << "Final state:      ";
+
+	if( results.finished == false )
+		cout << "not recorded";
+	else if( results.matched )
+		cout << "matches";
+	else
+		cout << "DOES NOT MATCH";
+
+	cout << endl;
+}
+
+/***************************************************************
+*   Purpose: Writes the header: the Board's size, seed and the
+*			 Cell PlaceBombs() kept clear. Starts the clock for the
+*			 entries' times.
+*
+*     Entry: The Board, with its bombs placed.
+*
+*      Exit: None
+****************************************************************/
+void Journal::WriteHeader( const Board & board )
+{
+	JournalHeader header = JournalHeader();
+
+	memcpy( header.magic, JOURNAL_MAGIC, sizeof( header.magic ) );
+	header.version = JOURNAL_VERSION;
+	header.chunked = board.IsChunked() ? 1 : 0;
+	header.rows = board.GetRows();
+	header.cols = board.GetCols();
+	header.bombs = board.GetBombs();
+	header.seed = board.GetSeed();
+	board.GetSafeCell( header.safe_row, header.safe_col );
+
+	m_file.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+	m_started = true;
+	m_start = std::chrono::steady_clock::now();
+}
+
+/***************************************************************
+*   Purpose: Appends one entry and flushes it, so that it is in
+*			 the file even if the program stops right after.
+*
+*     Entry: The fields of the entry.
+*
+*      Exit: None
+****************************************************************/
+void Journal::WriteEntry( int row, int col, unsigned int value, char action, char lost )
+{
+	JournalEntry entry = JournalEntry();
+
+	entry.row = row;
+	entry.col = col;
+	entry.value = value;
+	entry.action = action;
+	entry.lost = lost;
+
+	m_file.write( reinterpret_cast<const char *>( &entry ), sizeof( entry ) );
+	m_file.flush();
+}
+
+/***************************************************************
+*   Purpose: Closes the file.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Journal::~Journal()
+{
+	Close();
+}
@@ -0,0 +1,85 @@
+/************************************************************************
+* CLASS: Journal
+*
+* CONSTRUCTORS:
+*	Journal()
+*		Default constructor for Journal. No file is open.
+*
+* METHODS:
+*	bool Open( const char * path )
+*		Creates the journal file, replacing one that is there. Returns
+*		false if it could not be created.
+*	void Record( const Board & board, int row, int col, char action )
+*		Appends an action to the journal. The first action also writes
+*		the Board's size, seed and kept-clear Cell.
+*	void Finish( const Board & board )
+*		Appends the final state of the Board so that a replay can check
+*		it, and closes the file.
+*	void Close()
+*		Closes the file without a final state.
+*	bool IsOpen() const
+*		Tells whether a file is open.
+*	static bool Replay( const char * path, Board & board, ReplayResults & results )
+*		Sets up the Board from a journal and plays every action in it as
+*		fast as it can. Returns false if the file is not a journal.
+*	static void Report( const ReplayResults & results )
+*		Prints the moves, moves per second and whether the final state
+*		matched.
+*	~Journal()
+*		Closes the file.
+*
+* NOTES:
+*	A journal is a 64 byte header followed by one 16 byte entry per
+*	action: the row, the column, the milliseconds since the first action
+*	and the action itself. Entries are only ever appended, and each one
+*	is flushed as it is written, so a journal cut short by a crash can
+*	still be replayed up to the last action.
+*
+*	Finish() appends an 'E' entry holding the number of covered and
+*	flagged Cells, whether the game was lost and the Board's checksum.
+*	Replay() compares the replayed Board against it.
+*
+*	The board is rebuilt with PlaceBombs() from the seed, so a journal
+*	can only be made of a Board whose bombs were placed that way.
+*************************************************************************/
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <chrono>
+#include <fstream>
+#include "Board.h"
+
+struct ReplayResults
+{
+	long long moves;
+	double    seconds;
+	bool      finished; // The journal has a final state
+	bool      matched;  // The replayed Board matched it
+};
+
+class Journal
+{
+	public:
+		Journal();
+		bool Open( const char * path );
+		void Record( const Board & board, int row, int col, char action );
+		void Finish( const Board & board );
+		void Close();
+		bool IsOpen() const;
+		static bool Replay( const char * path, Board & board, ReplayResults & results );
+		static void Report( const ReplayResults & results );
+		~Journal();
+
+	private:
+		Journal( const Journal & copy );
+		Journal & operator=( const Journal & rhs );
+
+		void WriteHeader( const Board & board );
+		void WriteEntry( int row, int col, unsigned int value, char action, char lost );
+
+		std::ofstream m_file;
+		bool m_started; // The header has been written
+		std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
@@ -23,17 +23,366 @@
 *		 B  ? F ? ? X 2 ?...
 *		 C  1 ? ? ? ? 1 ?...
 *				 ...
+*
+* COMMAND LINE:
+*	--simulate <games> [rows cols bombs] [threads] [seed]
+*		Plays the given number of games with the built-in automatic
+*		player and no console I/O, then reports the win rate, moves
+*		per game and games per second.
+*	--generate [rows cols bombs] [threads] [seed]
+*		Finds a board that can be solved without guessing from a first
+*		click in the middle, trying candidates on all cores, then reports
+*		its seed, the attempts made and the time to board.
+*	--replay <file>
+*		Replays a journal recorded with --record without any console
+*		I/O, checks the final board against the one recorded and reports
+*		the moves per second.
+*	--serve <port|path> [seconds]
+*		Hosts games for any number of clients at once over TCP, if given
+*		a port number, or over a Unix socket at the path given. Serves
+*		until the time is up (forever if none is given), then reports the
+*		connection counts and request latencies. See GameServer.h for the
+*		protocol.
+*	--script <file|-> [rows cols bombs] [seed] [render every]
+*		Plays one game from a file of moves, or from standard input if
+*		the file is "-", with no prompts. A move is typed the same as at
+*		the prompts, such as "C4U" (U, F or C for the action), and moves
+*		are separated by whitespace.
+*		The Board is drawn every given number of moves (by default only
+*		at the end), then the moves per second and the bytes and
+*		writes per frame are reported. --record can be given after it.
+*	--view [rows cols bombs] [seed]
+*		Plays one game with the keys on a Board of any size, by default
+*		1000x1000 with 150000 mines, drawing only the part around the
+*		cursor that fits on the screen. The arrow keys (or h, j, k and l)
+*		move the cursor, U or space uncovers, F flags, C chords and Q
+*		quits. A Board of more than 4096x4096 cells is chunked: its
+*		cells are made 64x64 at a time as play reaches them, with the
+*		mines at the same density, so it can be up to the largest int
+*		each way. --record can be given after it.
+*	--no-guess
+*		Plays the game, but every board can be solved from the first
+*		click without guessing.
+*	--record <file>
+*		Plays the game and records every move of the last game played
+*		into the given journal. Can be combined with --no-guess.
+*	--hints
+*		Plays the game, but before every move shows a cell that the
+*		solver has proven safe, if it has found one. Can be combined
+*		with --no-guess and --record.
 ************************************************************/
+#if defined( _WIN32 )
 #include <crtdbg.h> 
 #define  _CRTDBG_MAP_ALLOC
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include "GameServer.h"
+#include "Journal.h"
 #include "Minesweeper.h"
+#include "NoGuessGenerator.h"
+#include "Simulator.h"
 
-int main()
+/***************************************************************
+*   Purpose: Runs the headless batch mode that was asked for on
+*			 the command line.
+*
+*     Entry: The command line arguments, starting at --simulate.
+*
+*      Exit: Returns the exit code for the program.
+****************************************************************/
+int RunSimulation( int argc, char * argv[] )
 {
-	_CrtSetDbgFlag( _CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF );
+	long long games = 100000;
+	int rows = 10;
+	int cols = 10;
+	int bombs = 10;
+	int threads = 0;
+	unsigned long long seed = 0;
+
+	if( argc > 2 )
+		games = atoll( argv[2] );
+
+	if( argc > 5 )
+	{
+		rows = atoi( argv[3] );
+		cols = atoi( argv[4] );
+		bombs = atoi( argv[5] );
+	}
+
+	if( argc > 6 )
+		threads = atoi( argv[6] );
+
+	if( argc > 7 )
+		seed = strtoull( argv[7], nullptr, 10 );
+
+	if( rows <= 0 || cols <= 0 || bombs < 0 || bombs >= rows * cols )
+	{
+		cout << "ERROR: Invalid board size." << endl;
+		return 1;
+	}
+
+	Simulator simulator( rows, cols, bombs );
+
+	simulator.SetThreads( threads );
+	simulator.SetSeed( seed );
+
+	Simulator::Report( simulator.Run( games ) );
+
+	return 0;
+}
+
+/***************************************************************
+*   Purpose: Runs the headless no-guess generator that was asked
+*			 for on the command line.
+*
+*     Entry: The command line arguments, starting at --generate.
+*
+*      Exit: Returns the exit code for the program.
+****************************************************************/
+int RunGeneration( int argc, char * argv[] )
+{
+	int rows = 10;
+	int cols = 10;
+	int bombs = 10;
+	int threads = 0;
+	unsigned long long seed = 0;
+
+	if( argc > 4 )
+	{
+		rows = atoi( argv[2] );
+		cols = atoi( argv[3] );
+		bombs = atoi( argv[4] );
+	}
+
+	if( argc > 5 )
+		threads = atoi( argv[5] );
+
+	if( argc > 6 )
+		seed = strtoull( argv[6], nullptr, 10 );
+
+	if( rows <= 0 || cols <= 0 || bombs < 0 || bombs > rows * cols - 9 )
+	{
+		cout << "ERROR: Invalid board size." << endl;
+		return 1;
+	}
+
+	NoGuessGenerator generator( rows, cols, bombs );
+	Board board( rows, cols, bombs );
+
+	generator.SetThreads( threads );
+	generator.SetSeed( seed );
+
+	GenerationResults results = generator.Generate( rows / 2, cols / 2, board );
+
+	NoGuessGenerator::Report( results );
+
+	return results.found ? 0 : 1;
+}
+
+/***************************************************************
+*   Purpose: Runs the headless replay of a journal that was asked
+*			 for on the command line.
+*
+*     Entry: The command line arguments, starting at --replay.
+*
+*      Exit: Returns the exit code for the program.
+****************************************************************/
+int RunReplay( int argc, char * argv[] )
+{
+	Board board;
+	ReplayResults results;
+
+	if( argc < 3 )
+	{
+		cout << "ERROR: No journal given." << endl;
+		return 1;
+	}
+
+	if( Journal::Replay( argv[2], board, results ) == false )
+		return 1;
+
+	Journal::Report( results );
+
+	return ( results.finished == false || results.matched ) ? 0 : 1;
+}
+
+/***************************************************************
+*   Purpose: Runs the multi-game server that was asked for on the
+*			 command line.
+*
+*     Entry: The command line arguments, starting at --serve.
+*
+*      Exit: Returns the exit code for the program.
+****************************************************************/
+int RunServer( int argc, char * argv[] )
+{
+	GameServer server;
+	double seconds = 0;
+
+	if( argc < 3 )
+	{
+		cout << "ERROR: No address given." << endl;
+		return 1;
+	}
+
+	if( argc > 3 )
+		seconds = atof( argv[3] );
 
+	if( server.Listen( argv[2] ) == false )
+		return 1;
+
+	cout << "Serving games on " << argv[2] << endl;
+
+	GameServer::Report( server.Run( seconds ) );
+
+	return 0;
+}
+
+/***************************************************************
+*   Purpose: Plays the scripted game that was asked for on the
+*			 command line.
+*
+*     Entry: The command line arguments, starting at --script.
+*
+*      Exit: Returns the exit code for the program.
+****************************************************************/
+int RunScript( int argc, char * argv[] )
+{
+	Minesweeper game;
+	int rows = 10;
+	int cols = 10;
+	int bombs = 10;
+	unsigned long long seed = 0;
+	int render_every = 0;
+	int numbers = 0;
+
+	if( argc < 3 )
+	{
+		cout << "ERROR: No script given." << endl;
+		return 1;
+	}
+
+	// The optional numbers come first, then any --record
+	while( 3 + numbers < argc && strncmp( argv[3 + numbers], "--", 2 ) != 0 )
+		numbers++;
+
+	if( numbers >= 3 )
+	{
+		rows = atoi( argv[3] );
+		cols = atoi( argv[4] );
+		bombs = atoi( argv[5] );
+	}
+
+	if( numbers >= 4 )
+		seed = strtoull( argv[6], nullptr, 10 );
+
+	if( numbers >= 5 )
+		render_every = atoi( argv[7] );
+
+	if( rows <= 0 || cols <= 0 || bombs < 0 || bombs >= rows * cols )
+	{
+		cout << "ERROR: Invalid board size." << endl;
+		return 1;
+	}
+
+	for( int i = 3 + numbers; i + 1 < argc; ++i )
+		if( strcmp( argv[i], "--record" ) == 0 )
+			game.SetRecordPath( argv[i + 1] );
+
+	return game.PlayScript( argv[2], rows, cols, bombs, seed, render_every ) ? 0 : 1;
+}
+
+/***************************************************************
+*   Purpose: Plays the game in a scrolling window that was asked
+*			 for on the command line.
+*
+*     Entry: The command line arguments, starting at --view.
+*
+*      Exit: Returns the exit code for the program.
+****************************************************************/
+int RunView( int argc, char * argv[] )
+{
 	Minesweeper game;
+	int rows = 1000;
+	int cols = 1000;
+	int bombs = 150000;
+	unsigned long long seed = 0;
+	int numbers = 0;
+
+	// The optional numbers come first, then any --record
+	while( 2 + numbers < argc && strncmp( argv[2 + numbers], "--", 2 ) != 0 )
+		numbers++;
+
+	if( numbers >= 3 )
+	{
+		rows = atoi( argv[2] );
+		cols = atoi( argv[3] );
+		bombs = atoi( argv[4] );
+	}
+
+	if( numbers >= 4 )
+		seed = strtoull( argv[5], nullptr, 10 );
+
+	// The first uncover keeps its Cell and the eight around it clear
+	if( rows <= 0 || cols <= 0 || bombs < 0 ||
+		bombs > ( static_cast<long long>( rows ) * cols ) - 9 )
+	{
+		cout << "ERROR: Invalid board size." << endl;
+		return 1;
+	}
+
+	for( int i = 2 + numbers; i + 1 < argc; ++i )
+		if( strcmp( argv[i], "--record" ) == 0 )
+			game.SetRecordPath( argv[i + 1] );
+
+	game.PlayViewport( rows, cols, bombs, seed );
+
+	return 0;
+}
+
+int main( int argc, char * argv[] )
+{
+#if defined( _WIN32 )
+	_CrtSetDbgFlag( _CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF );
+#endif
+
+	if( argc > 1 && strcmp( argv[1], "--simulate" ) == 0 )
+		return RunSimulation( argc, argv );
+
+	if( argc > 1 && strcmp( argv[1], "--generate" ) == 0 )
+		return RunGeneration( argc, argv );
+
+	if( argc > 1 && strcmp( argv[1], "--replay" ) == 0 )
+		return RunReplay( argc, argv );
+
+	if( argc > 1 && strcmp( argv[1], "--serve" ) == 0 )
+		return RunServer( argc, argv );
+
+	if( argc > 1 && strcmp( argv[1], "--script" ) == 0 )
+		return RunScript( argc, argv );
+
+	if( argc > 1 && strcmp( argv[1], "--view" ) == 0 )
+		return RunView( argc, argv );
+
+	bool no_guess = false;
+	bool hints = false;
+	const char * record_path = nullptr;
+
+	for( int i = 1; i < argc; ++i )
+	{
+		if( strcmp( argv[i], "--no-guess" ) == 0 )
+			no_guess = true;
+		else if( strcmp( argv[i], "--hints" ) == 0 )
+			hints = true;
+		else if( strcmp( argv[i], "--record" ) == 0 && i + 1 < argc )
+			record_path = argv[++i];
+	}
+
+	Minesweeper game( no_guess );
 
+	game.SetRecordPath( record_path );
+	game.SetHints( hints );
 	game.StartGame();
 	
 	return 0;
@@ -0,0 +1,167 @@
+#if defined( _WIN32 )
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "Exception.h"
+#include "MappedFile.h"
+
+/***************************************************************
+*   Purpose: Default constructor for MappedFile. No file is open.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+MappedFile::MappedFile() : m_data( nullptr ), m_size( 0 ), m_mapping( nullptr )
+{ }
+
+/***************************************************************
+*   Purpose: Maps the whole file into memory, copy-on-write, so
+*			 that its pages are only read when they are touched and
+*			 changes made in memory never reach the file.
+*
+*     Entry: The path of the file, which must not be empty.
+*
+*      Exit: The file that was open before is closed. Throws an
+*			 Exception if the file cannot be opened or mapped.
+****************************************************************/
+void MappedFile::Open( const char * path )
+{
+	Close();
+
+#if defined( _WIN32 )
+	HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+							   FILE_ATTRIBUTE_NORMAL, NULL );
+	LARGE_INTEGER size;
+
+	if( file == INVALID_HANDLE_VALUE )
+		throw Exception( "ERROR: Could not open the file" );
+
+	if( GetFileSizeEx( file, &size ) == FALSE || size.QuadPart == 0 )
+	{
+		CloseHandle( file );
+		throw Exception( "ERROR: The file is empty" );
+	}
+
+	HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+
+	// The mapping keeps the file open by itself
+	CloseHandle( file );
+
+	if( mapping == NULL )
+		throw Exception( "ERROR: Could not map the file" );
+
+	void * view = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+
+	if( view == NULL )
+	{
+		CloseHandle( mapping );
+		throw Exception( "ERROR: Could not map the file" );
+	}
+
+	m_data = static_cast<unsigned char *>( view );
+	m_size = static_cast<unsigned long long>( size.QuadPart );
+	m_mapping = mapping;
+#else
+	const int file = open( path, O_RDONLY );
+	struct stat info;
+
+	if( file < 0 )
+		throw Exception( "ERROR: Could not open the file" );
+
+	if( fstat( file, &info ) != 0 || info.st_size == 0 )
+	{
+		close( file );
+		throw Exception( "ERROR: The file is empty" );
+	}
+
+	void * view = mmap( nullptr, static_cast<size_t>( info.st_size ), PROT_READ | PROT_WRITE,
+						MAP_PRIVATE, file, 0 );
+
+	// The mapping keeps the file open by itself
+	close( file );
+
+	if( view == MAP_FAILED )
+		throw Exception( "ERROR: Could not map the file" );
+
+	m_data = static_cast<unsigned char *>( view );
+	m_size = static_cast<unsigned long long>( info.st_size );
+#endif
+}
+
+/***************************************************************
+*   Purpose: Unmaps the file. Any changes made in memory are
+*			 thrown away.
+*
+*     Entry: None
+*
+*      Exit: No file is open.
+****************************************************************/
+void MappedFile::Close()
+{
+	if( m_data == nullptr )
+		return;
+
+#if defined( _WIN32 )
+	UnmapViewOfFile( m_data );
+	CloseHandle( static_cast<HANDLE>( m_mapping ) );
+#else
+	munmap( m_data, static_cast<size_t>( m_size ) );
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+}
+
+/***************************************************************
+*   Purpose: Tells whether a file is mapped.
+*
+*     Entry: None
+*
+*      Exit: Returns true if one is.
+****************************************************************/
+bool MappedFile::IsOpen() const
+{
+	return m_data != nullptr;
+}
+
+/***************************************************************
+*   Purpose: Gets the first byte of the file.
+*
+*     Entry: None
+*
+*      Exit: Returns the first byte, or nullptr if no file is open.
+****************************************************************/
+unsigned char * MappedFile::data()
+{
+	return m_data;
+}
+
+/***************************************************************
+*   Purpose: Gets the size of the file in bytes.
+*
+*     Entry: None
+*
+*      Exit: Returns the size, or 0 if no file is open.
+****************************************************************/
+unsigned long long MappedFile::size() const
+{
+	return m_size;
+}
+
+/***************************************************************
+*   Purpose: Unmaps the file if one is open.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+MappedFile::~MappedFile()
+{
+	Close();
+}
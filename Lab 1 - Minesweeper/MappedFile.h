@@ -0,0 +1,53 @@
+/************************************************************************
+* CLASS: MappedFile
+*
+* CONSTRUCTORS:
+*	MappedFile()
+*		Default constructor for MappedFile. No file is open.
+*
+* METHODS:
+*	void Open( const char * path )
+*		Maps the whole file into memory. Throws an Exception if it cannot.
+*	void Close()
+*		Unmaps the file. Pointers into it are no longer valid.
+*	bool IsOpen() const
+*		Tells whether a file is mapped.
+*	unsigned char * data()
+*		Gets the first byte of the file.
+*	unsigned long long size() const
+*		Gets the size of the file in bytes.
+*	~MappedFile()
+*		Unmaps the file if one is open.
+*
+* NOTES:
+*	The file is mapped copy-on-write: its bytes can be changed in memory,
+*	but the changes are never written back to the file. Pages of the file
+*	are only read from disk the first time they are touched, so opening
+*	is quick whatever the size of the file.
+*
+*	A MappedFile cannot be copied, since only one object may unmap it.
+*************************************************************************/
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+class MappedFile
+{
+	public:
+		MappedFile();
+		void Open( const char * path );
+		void Close();
+		bool IsOpen() const;
+		unsigned char * data();
+		unsigned long long size() const;
+		~MappedFile();
+
+	private:
+		MappedFile( const MappedFile & copy );
+		MappedFile & operator=( const MappedFile & rhs );
+
+		unsigned char * m_data;
+		unsigned long long m_size;
+		void * m_mapping; // Handle of the file mapping on Windows
+};
+
+#endif
@@ -0,0 +1,828 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "MineProbability.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Layers whose weights get this far from 1 are scaled back
+const double SCALE_LIMIT = 1e150;
+
+// Limit on the weights kept for combining components, so that a huge
+// frontier gives up instead of using up all of the memory
+const size_t MAX_STORED_WEIGHTS = 8 * 1024 * 1024;
+
+/***************************************************************
+*   Purpose: Default constructor for MineProbability. There is no
+*			 time or step budget.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+MineProbability::MineProbability() : m_budget( 0 ), m_step_budget( 0 ), m_cancel( false ),
+									 m_checks( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Sets how long Compute() may run before it gives up.
+*
+*     Entry: The budget in seconds. 0 means no limit.
+*
+*      Exit: None
+****************************************************************/
+void MineProbability::SetTimeBudget( double seconds )
+{
+	m_budget = seconds;
+}
+
+/***************************************************************
+*   Purpose: Sets how many steps Compute() may take before it
+*			 gives up. A step is one state of one Cell of the
+*			 frontier, so the same board always takes the same
+*			 number of steps whatever the machine or its load.
+*
+*     Entry: The budget in steps. 0 means no limit.
+*
+*      Exit: None
+****************************************************************/
+void MineProbability::SetStepBudget( long long steps )
+{
+	m_step_budget = steps;
+}
+
+/***************************************************************
+*   Purpose: Makes a Compute() that is running on another thread
+*			 give up as soon as it next checks. The request is
+*			 cleared when the next Compute() starts.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void MineProbability::Cancel()
+{
+	m_cancel = true;
+}
+
+/***************************************************************
+*   Purpose: Works out the exact chance that each Cell of the
+*			 Board is a bomb. See Compute( const CellGrid & ).
+*
+*     Entry: The Board, which must not be chunked, and the grid to
+*			 fill in.
+*
+*      Exit: The same as Compute( const CellGrid & ).
+****************************************************************/
+bool MineProbability::Compute( const Board & board, std::vector<double> & grid )
+{
+	return Compute( board.GetGrid(), grid );
+}
+
+/***************************************************************
+*   Purpose: Works out the exact chance that each Cell is a bomb,
+*			 given the numbers and flags on the board and the
+*			 number of bombs it holds.
+*
+*     Entry: A view of the board and the grid to fill in.
+*
+*      Exit: grid[( row * cols ) + col] holds the chance for the
+*			 Cell: 0 for uncovered Cells and 1 for flagged ones.
+*			 Returns false if the time or steps ran out, it was
+*			 cancelled, the frontier was too big to combine or the
+*			 Board contradicts itself. The grid is not usable then.
+****************************************************************/
+bool MineProbability::Compute( const CellGrid & board, std::vector<double> & grid )
+{
+	int flags = 0;
+	int covered = 0;
+
+	m_cancel = false;
+	m_checks = 0;
+	m_deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>( m_budget ) );
+
+	for( int r = 0; r < board.GetRows(); ++r )
+	{
+		for( int c = 0; c < board.GetCols(); ++c )
+		{
+			const Cell & cell = board.GetCell( r, c );
+
+			if( cell.IsCovered() && cell.IsFlagged() )
+				flags++;
+			else if( cell.IsCovered() )
+				covered++;
+		}
+	}
+
+	if( BuildComponents( board, grid ) == false )
+		return false;
+
+	const int frontier = static_cast<int>( m_frontier.size() );
+	const int interior = covered - frontier;
+	const int remaining = board.GetBombs() - flags;
+	const int num_components = static_cast<int>( m_components.size() );
+	std::vector<Layer> layers;
+
+	if( remaining < 0 )
+		return false;
+
+	// Solutions of every component by bomb count
+	for( int i = 0; i < num_components; ++i )
+	{
+		if( Forward( m_components[i], layers ) == false )
+			return false;
+
+		m_components[i].counts = layers.back().states[0];
+	}
+
+	// The ways the interior can hold the rest of the bombs, scaled so
+	// that the largest that can happen is 1
+	const int lowest = std::max( 0, remaining - frontier );
+	const int highest = std::min( interior, remaining );
+
+	if( lowest > highest )
+		return false;
+
+	const double log_max = LogBinomial( interior, std::min( std::max( interior / 2, lowest ), highest ) );
+	std::vector<double> interior_ways( highest + 1, 0.0 );
+
+	for( int r = lowest; r <= highest; ++r )
+		interior_ways[r] = exp( LogBinomial( interior, r ) - log_max );
+
+	// before[i] holds the bomb counts of components 0 to i - 1 put
+	// together
+	std::vector<Weights> before( num_components + 1 );
+	size_t stored = 0;
+
+	before[0].lo = 0;
+	before[0].ways.assign( 1, 1.0 );
+
+	for( int i = 0; i < num_components; ++i )
+	{
+		before[i + 1] = Multiply( before[i], m_components[i].counts );
+
+		if( static_cast<int>( before[i + 1].ways.size() ) + before[i + 1].lo > remaining + 1 )
+			before[i + 1].ways.resize( std::max( 0, remaining + 1 - before[i + 1].lo ) );
+
+		stored += before[i + 1].ways.size();
+
+		if( before[i + 1].ways.empty() || stored > MAX_STORED_WEIGHTS || OutOfTime() )
+			return false;
+	}
+
+	// after[j] is the weight of the rest of the Board (components
+	// after the current one and the interior) when j bombs have been
+	// used up to and including the current component
+	std::vector<double> after( remaining + 1, 0.0 );
+	std::vector<double> folded( remaining + 1, 0.0 );
+	double total = 0;
+	double interior_bombs = 0;
+
+	for( int j = 0; j <= remaining; ++j )
+	{
+		if( remaining - j <= highest )
+			after[j] = interior_ways[remaining - j];
+	}
+
+	for( int j = 0; j < static_cast<int>( before[num_components].ways.size() ); ++j )
+	{
+		const int bombs = before[num_components].lo + j;
+		const double ways = before[num_components].ways[j] * after[bombs];
+
+		total += ways;
+		interior_bombs += ways * ( remaining - bombs );
+	}
+
+	if( total <= 0 )
+		return false;
+
+	if( interior > 0 )
+	{
+		const double chance = interior_bombs / ( total * interior );
+
+		for( int r = 0; r < board.GetRows(); ++r )
+		{
+			for( int c = 0; c < board.GetCols(); ++c )
+			{
+				const Cell & cell = board.GetCell( r, c );
+				const int index = ( r * board.GetCols() ) + c;
+
+				if( cell.IsCovered() && cell.IsFlagged() == false && m_position[index] < 0 )
+					grid[index] = chance;
+			}
+		}
+	}
+
+	for( int i = num_components - 1; i >= 0; --i )
+	{
+		const Weights & counts = m_components[i].counts;
+		const Weights & prefix = before[i];
+		Weights weight;
+		double largest = 0;
+
+		// weight(k) = sum over a of prefix(a) * after(a + k)
+		weight.lo = counts.lo;
+		weight.ways.assign( counts.ways.size(), 0.0 );
+
+		for( size_t k = 0; k < counts.ways.size(); ++k )
+		{
+			for( size_t a = 0; a < prefix.ways.size(); ++a )
+			{
+				const int bombs = prefix.lo + static_cast<int>( a ) + counts.lo + static_cast<int>( k );
+
+				if( bombs <= remaining )
+					weight.ways[k] += prefix.ways[a] * after[bombs];
+			}
+
+			largest = std::max( largest, weight.ways[k] );
+		}
+
+		if( largest <= 0 || OutOfTime() )
+			return false;
+
+		for( size_t k = 0; k < weight.ways.size(); ++k )
+			weight.ways[k] /= largest;
+
+		if( Forward( m_components[i], layers ) == false ||
+			Backward( m_components[i], layers, weight, grid ) == false )
+		{
+			return false;
+		}
+
+		// Fold this component into the weight of the rest of the Board.
+		// Only the bomb counts the earlier components can reach matter.
+		largest = 0;
+
+		for( int j = prefix.lo; j < prefix.lo + static_cast<int>( prefix.ways.size() ); ++j )
+		{
+			folded[j] = 0;
+
+			for( size_t k = 0; k < counts.ways.size(); ++k )
+			{
+				const int bombs = j + counts.lo + static_cast<int>( k );
+
+				if( bombs <= remaining )
+					folded[j] += counts.ways[k] * after[bombs];
+			}
+
+			largest = std::max( largest, folded[j] );
+		}
+
+		if( largest > 0 )
+		{
+			for( int j = prefix.lo; j < prefix.lo + static_cast<int>( prefix.ways.size() ); ++j )
+				folded[j] /= largest;
+		}
+
+		after.swap( folded );
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Reads the numbers on the Board into constraints on
+*			 the frontier Cells and splits the frontier into
+*			 components that share no number.
+*
+*     Entry: The Board and the grid, which is sized and cleared.
+*
+*      Exit: Flagged Cells are set to 1 in the grid. Returns false
+*			 if a number cannot be satisfied.
+****************************************************************/
+bool MineProbability::BuildComponents( const CellGrid & board, std::vector<double> & grid )
+{
+	const int rows = board.GetRows();
+	const int cols = board.GetCols();
+	std::vector<int> frontier_id( rows * cols, -1 );
+
+	grid.assign( rows * cols, 0.0 );
+	m_constraint_cells.clear();
+	m_constraint_need.clear();
+	m_cell_constraints.clear();
+	m_frontier.clear();
+	m_components.clear();
+
+	for( int r = 0; r < rows; ++r )
+	{
+		for( int c = 0; c < cols; ++c )
+		{
+			const Cell & cell = board.GetCell( r, c );
+
+			if( cell.IsCovered() )
+			{
+				if( cell.IsFlagged() )
+					grid[( r * cols ) + c] = 1.0;
+
+				continue;
+			}
+
+			std::vector<int> cells;
+			int need = cell.GetNumBombs();
+
+			for( int nr = r - 1; nr <= r + 1; ++nr )
+			{
+				for( int nc = c - 1; nc <= c + 1; ++nc )
+				{
+					if( nr < 0 || nr >= rows || nc < 0 || nc >= cols )
+						continue;
+
+					const Cell & neighbour = board.GetCell( nr, nc );
+
+					if( neighbour.IsCovered() && neighbour.IsFlagged() )
+						need--;
+					else if( neighbour.IsCovered() )
+						cells.push_back( ( nr * cols ) + nc );
+				}
+			}
+
+			if( need < 0 || need > static_cast<int>( cells.size() ) )
+				return false;
+
+			if( cells.empty() )
+				continue;
+
+			const int constraint = static_cast<int>( m_constraint_need.size() );
+
+			for( size_t i = 0; i < cells.size(); ++i )
+			{
+				int & id = frontier_id[cells[i]];
+
+				if( id < 0 )
+				{
+					id = static_cast<int>( m_frontier.size() );
+					m_frontier.push_back( cells[i] );
+					m_cell_constraints.push_back( std::vector<int>() );
+				}
+
+				m_cell_constraints[id].push_back( constraint );
+				cells[i] = id;
+			}
+
+			m_constraint_cells.push_back( cells );
+			m_constraint_need.push_back( need );
+		}
+	}
+
+	// Group the frontier Cells that are joined through numbers
+	std::vector<int> component_of( m_frontier.size(), -1 );
+
+	for( size_t start = 0; start < m_frontier.size(); ++start )
+	{
+		if( component_of[start] >= 0 )
+			continue;
+
+		const int id = static_cast<int>( m_components.size() );
+		std::vector<int> stack( 1, static_cast<int>( start ) );
+
+		m_components.push_back( Component() );
+		component_of[start] = id;
+
+		while( stack.empty() == false )
+		{
+			const int cell = stack.back();
+
+			stack.pop_back();
+			m_components[id].cells.push_back( cell );
+
+			for( size_t i = 0; i < m_cell_constraints[cell].size(); ++i )
+			{
+				const std::vector<int> & others = m_constraint_cells[m_cell_constraints[cell][i]];
+
+				for( size_t j = 0; j < others.size(); ++j )
+				{
+					if( component_of[others[j]] < 0 )
+					{
+						component_of[others[j]] = id;
+						stack.push_back( others[j] );
+					}
+				}
+			}
+		}
+	}
+
+	for( size_t i = 0; i < m_constraint_cells.size(); ++i )
+		m_components[component_of[m_constraint_cells[i][0]]].constraints.push_back( static_cast<int>( i ) );
+
+	// m_position is indexed by Board Cell from here on, so that Compute()
+	// can tell the frontier from the interior
+	m_position.assign( rows * cols, -1 );
+
+	for( size_t i = 0; i < m_components.size(); ++i )
+		OrderCells( m_components[i] );
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Puts the Cells of a component in a line by walking
+*			 out from a Cell with the fewest numbers, so that the
+*			 Cells of each number end up close together.
+*
+*     Entry: The component.
+*
+*      Exit: The Cells are in walking order and m_position holds
+*			 each Cell's place in it.
+****************************************************************/
+void MineProbability::OrderCells( Component & component )
+{
+	std::vector<int> order;
+	size_t start = 0;
+
+	for( size_t i = 1; i < component.cells.size(); ++i )
+	{
+		if( m_cell_constraints[component.cells[i]].size() <
+			m_cell_constraints[component.cells[start]].size() )
+		{
+			start = i;
+		}
+	}
+
+	order.push_back( component.cells[start] );
+	m_position[m_frontier[component.cells[start]]] = 0;
+
+	for( size_t next = 0; next < order.size(); ++next )
+	{
+		const std::vector<int> & constraints = m_cell_constraints[order[next]];
+
+		for( size_t i = 0; i < constraints.size(); ++i )
+		{
+			const std::vector<int> & cells = m_constraint_cells[constraints[i]];
+
+			for( size_t j = 0; j < cells.size(); ++j )
+			{
+				int & place = m_position[m_frontier[cells[j]]];
+
+				if( place < 0 )
+				{
+					place = static_cast<int>( order.size() );
+					order.push_back( cells[j] );
+				}
+			}
+		}
+	}
+
+	component.cells.swap( order );
+}
+
+/***************************************************************
+*   Purpose: Walks the Cells of a component in order, trying each
+*			 as safe and as a bomb. Partial solutions whose open
+*			 numbers still need the same bombs are merged into one
+*			 state that counts its ways by bomb count.
+*
+*     Entry: The component and the layers to fill in.
+*
+*      Exit: layers[d] holds the states before Cell d and where
+*			 each of them leads. The last layer has a single state
+*			 holding the solutions by bomb count. Returns false if
+*			 there is no solution or the time ran out.
+****************************************************************/
+bool MineProbability::Forward( const Component & component, std::vector<Layer> & layers )
+{
+	const int n = static_cast<int>( component.cells.size() );
+	const int num_constraints = static_cast<int>( component.constraints.size() );
+	std::vector<int> first( num_constraints, n );
+	std::vector<int> last( num_constraints, -1 );
+	std::vector<int> slot( num_constraints, -1 );
+	std::vector<std::vector<int> > cell_constraints( n );
+	std::vector<std::vector<int> > active( n + 1 );
+	std::vector<int> need( num_constraints, 0 );
+
+	for( int i = 0; i < num_constraints; ++i )
+	{
+		const std::vector<int> & cells = m_constraint_cells[component.constraints[i]];
+
+		for( size_t j = 0; j < cells.size(); ++j )
+		{
+			const int place = m_position[m_frontier[cells[j]]];
+
+			first[i] = std::min( first[i], place );
+			last[i] = std::max( last[i], place );
+			cell_constraints[place].push_back( i );
+		}
+	}
+
+	// active[d] lists the numbers that have Cells both before and at
+	// or after Cell d, in the order their needs are kept in the keys
+	for( int d = 0; d < n; ++d )
+	{
+		for( size_t i = 0; i < active[d].size(); ++i )
+		{
+			if( last[active[d][i]] > d )
+				active[d + 1].push_back( active[d][i] );
+		}
+
+		for( size_t i = 0; i < cell_constraints[d].size(); ++i )
+		{
+			const int constraint = cell_constraints[d][i];
+
+			if( first[constraint] == d && last[constraint] > d )
+				active[d + 1].push_back( constraint );
+		}
+	}
+
+	layers.assign( n + 1, Layer() );
+	layers[0].keys.push_back( std::vector<unsigned char>() );
+	layers[0].states.push_back( Weights() );
+	layers[0].states[0].lo = 0;
+	layers[0].states[0].ways.assign( 1, 1.0 );
+
+	for( int d = 0; d < n; ++d )
+	{
+		Layer & layer = layers[d];
+		Layer & next = layers[d + 1];
+		std::map<std::vector<unsigned char>, int> index;
+		double largest = 0;
+
+		for( size_t i = 0; i < active[d].size(); ++i )
+			slot[active[d][i]] = static_cast<int>( i );
+
+		layer.next[0].assign( layer.states.size(), -1 );
+		layer.next[1].assign( layer.states.size(), -1 );
+
+		for( size_t s = 0; s < layer.states.size(); ++s )
+		{
+			if( OutOfTime() )
+				return false;
+
+			for( int x = 0; x <= 1; ++x )
+			{
+				bool valid = true;
+
+				// What the numbers touching this Cell need after it
+				for( size_t i = 0; i < cell_constraints[d].size() && valid; ++i )
+				{
+					const int constraint = cell_constraints[d][i];
+					const std::vector<int> & cells = m_constraint_cells[component.constraints[constraint]];
+					int later = 0;
+
+					if( first[constraint] == d )
+						need[constraint] = m_constraint_need[component.constraints[constraint]] - x;
+					else
+						need[constraint] = layer.keys[s][slot[constraint]] - x;
+
+					for( size_t j = 0; j < cells.size(); ++j )
+					{
+						if( m_position[m_frontier[cells[j]]] > d )
+							later++;
+					}
+
+					valid = ( need[constraint] >= 0 && need[constraint] <= later );
+				}
+
+				if( valid == false )
+					continue;
+
+				std::vector<unsigned char> key( active[d + 1].size() );
+
+				for( size_t i = 0; i < active[d + 1].size(); ++i )
+				{
+					const int constraint = active[d + 1][i];
+					bool touched = false;
+
+					for( size_t j = 0; j < cell_constraints[d].size() && touched == false; ++j )
+						touched = ( cell_constraints[d][j] == constraint );
+
+					if( touched )
+						key[i] = static_cast<unsigned char>( need[constraint] );
+					else
+						key[i] = layer.keys[s][slot[constraint]];
+				}
+
+				std::map<std::vector<unsigned char>, int>::iterator found = index.find( key );
+				int target = 0;
+
+				if( found == index.end() )
+				{
+					target = static_cast<int>( next.states.size() );
+					index[key] = target;
+					next.keys.push_back( key );
+					next.states.push_back( Weights() );
+					next.states[target].lo = layer.states[s].lo + x;
+				}
+				else
+					target = found->second;
+
+				// Add this state's ways, moved up by x bombs
+				Weights & to = next.states[target];
+				const Weights & from = layer.states[s];
+				const int lo = std::min( to.lo, from.lo + x );
+				const int hi = std::max( to.lo + static_cast<int>( to.ways.size() ),
+										 from.lo + x + static_cast<int>( from.ways.size() ) );
+
+				if( lo < to.lo )
+					to.ways.insert( to.ways.begin(), to.lo - lo, 0.0 );
+
+				to.lo = lo;
+				to.ways.resize( hi - lo, 0.0 );
+
+				for( size_t k = 0; k < from.ways.size(); ++k )
+				{
+					double & ways = to.ways[from.lo + x + k - lo];
+
+					ways += from.ways[k];
+					largest = std::max( largest, ways );
+				}
+
+				layer.next[x][s] = target;
+			}
+		}
+
+		if( next.states.empty() )
+			return false;
+
+		if( largest > SCALE_LIMIT || largest < 1 / SCALE_LIMIT )
+		{
+			for( size_t s = 0; s < next.states.size(); ++s )
+			{
+				for( size_t k = 0; k < next.states[s].ways.size(); ++k )
+					next.states[s].ways[k] /= largest;
+			}
+		}
+
+		for( size_t i = 0; i < active[d].size(); ++i )
+			slot[active[d][i]] = -1;
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Walks the layers from the last Cell back to the first,
+*			 carrying for each state the weight of finishing from
+*			 it. A Cell's chance of being a bomb is the weight of
+*			 the solutions through it as a bomb over the weight of
+*			 all solutions, both counted at that Cell.
+*
+*     Entry: The component, the layers from Forward() and the
+*			 weight of the rest of the Board for each bomb count
+*			 of the component.
+*
+*      Exit: The chances of the component's Cells are in the grid.
+****************************************************************/
+bool MineProbability::Backward( const Component & component, std::vector<Layer> & layers,
+								const Weights & weight, std::vector<double> & grid )
+{
+	const int n = static_cast<int>( component.cells.size() );
+	std::vector<Weights> later( 1 );
+	std::vector<Weights> current;
+
+	// Finishing from the last state weighs each total by the rest
+	later[0].lo = layers[n].states[0].lo;
+	later[0].ways.assign( layers[n].states[0].ways.size(), 0.0 );
+
+	for( size_t k = 0; k < later[0].ways.size(); ++k )
+	{
+		const int bombs = later[0].lo + static_cast<int>( k ) - weight.lo;
+
+		if( bombs >= 0 && bombs < static_cast<int>( weight.ways.size() ) )
+			later[0].ways[k] = weight.ways[bombs];
+	}
+
+	for( int d = n - 1; d >= 0; --d )
+	{
+		const Layer & layer = layers[d];
+		double bomb = 0;
+		double all = 0;
+		double largest = 0;
+
+		current.assign( layer.states.size(), Weights() );
+
+		for( size_t s = 0; s < layer.states.size(); ++s )
+		{
+			const Weights & from = layer.states[s];
+			Weights & to = current[s];
+
+			if( OutOfTime() )
+				return false;
+
+			to.lo = from.lo;
+			to.ways.assign( from.ways.size(), 0.0 );
+
+			for( int x = 0; x <= 1; ++x )
+			{
+				if( layer.next[x][s] < 0 )
+					continue;
+
+				const Weights & rest = later[layer.next[x][s]];
+
+				for( size_t k = 0; k < from.ways.size(); ++k )
+				{
+					const int place = from.lo + static_cast<int>( k ) + x - rest.lo;
+
+					if( place < 0 || place >= static_cast<int>( rest.ways.size() ) )
+						continue;
+
+					to.ways[k] += rest.ways[place];
+					all += from.ways[k] * rest.ways[place];
+
+					if( x == 1 )
+						bomb += from.ways[k] * rest.ways[place];
+				}
+			}
+
+			for( size_t k = 0; k < to.ways.size(); ++k )
+				largest = std::max( largest, to.ways[k] );
+		}
+
+		grid[m_frontier[component.cells[d]]] = ( all > 0 ) ? bomb / all : 0.0;
+
+		if( largest > 0 )
+		{
+			for( size_t s = 0; s < current.size(); ++s )
+			{
+				for( size_t k = 0; k < current[s].ways.size(); ++k )
+					current[s].ways[k] /= largest;
+			}
+		}
+
+		later.swap( current );
+		layers[d + 1] = Layer();
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Tells whether Compute() should give up. Each call is
+*			 one step. The clock is only read every few hundred
+*			 steps.
+*
+*     Entry: None
+*
+*      Exit: Returns true if cancelled, past the deadline or over
+*			 the step budget.
+****************************************************************/
+bool MineProbability::OutOfTime()
+{
+	if( m_cancel )
+		return true;
+
+	++m_checks;
+
+	if( m_step_budget > 0 && m_checks > m_step_budget )
+		m_cancel = true;
+	else if( m_budget > 0 && ( m_checks & 255 ) == 0 && Clock::now() > m_deadline )
+		m_cancel = true;
+
+	return m_cancel;
+}
+
+/***************************************************************
+*   Purpose: Returns the natural log of "n choose k".
+*
+*     Entry: n and k, with 0 <= k <= n.
+*
+*      Exit: Returns the log.
+****************************************************************/
+double MineProbability::LogBinomial( int n, int k ) const
+{
+	return lgamma( n + 1.0 ) - lgamma( k + 1.0 ) - lgamma( n - k + 1.0 );
+}
+
+/***************************************************************
+*   Purpose: Multiplies two sets of weights by bomb count, as
+*			 polynomials, and scales the result so its largest
+*			 weight is 1.
+*
+*     Entry: The two sets of weights.
+*
+*      Exit: Returns the product.
+****************************************************************/
+MineProbability::Weights MineProbability::Multiply( const Weights & a, const Weights & b )
+{
+	Weights product;
+	double largest = 0;
+
+	product.lo = a.lo + b.lo;
+	product.ways.assign( a.ways.size() + b.ways.size() - 1, 0.0 );
+
+	for( size_t i = 0; i < a.ways.size(); ++i )
+	{
+		for( size_t j = 0; j < b.ways.size(); ++j )
+			product.ways[i + j] += a.ways[i] * b.ways[j];
+	}
+
+	for( size_t k = 0; k < product.ways.size(); ++k )
+		largest = std::max( largest, product.ways[k] );
+
+	if( largest > 0 )
+	{
+		for( size_t k = 0; k < product.ways.size(); ++k )
+			product.ways[k] /= largest;
+	}
+
+	return product;
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+MineProbability::~MineProbability()
+{ }
@@ -0,0 +1,118 @@
+/************************************************************************
+* CLASS: MineProbability
+*
+* CONSTRUCTORS:
+*	MineProbability()
+*		Default constructor for MineProbability. There is no time or step
+*		budget.
+*
+* METHODS:
+*	void SetTimeBudget( double seconds )
+*		Sets how long Compute() may run before it gives up. 0 means no
+*		limit.
+*	void SetStepBudget( long long steps )
+*		Sets how many steps Compute() may take before it gives up. Unlike
+*		the time budget, the same board always gets the same answer. 0
+*		means no limit.
+*	void Cancel()
+*		Makes a Compute() that is running on another thread give up as
+*		soon as it next checks.
+*	bool Compute( const Board & board, std::vector<double> & grid )
+*		Fills grid with the exact chance that each Cell is a bomb, given
+*		what a player can see on the Board. Returns false if the time or
+*		steps ran out, it was cancelled or the flags and numbers
+*		contradict each other.
+*	bool Compute( const CellGrid & board, std::vector<double> & grid )
+*		Same as Compute( const Board &, grid ), for any board that gives a
+*		CellGrid, such as a FixedBoard.
+*	~MineProbability()
+*		Destructs the object.
+*
+* NOTES:
+*	Only the numbers and flags are read, and flags are trusted. Covered
+*	Cells next to a number make up the frontier. The frontier is split
+*	into components that share no number, since those can be solved on
+*	their own.
+*
+*	The Cells of a component are put in a line so that each number only
+*	stays "open" for a short stretch of it. Walking the line, the partial
+*	solutions are merged whenever the open numbers still need the same
+*	amount of bombs, so the work grows with the number of distinct open
+*	states rather than with the number of solutions. Each state keeps how
+*	many ways it can be reached for every bomb count. A backward walk then
+*	gives every Cell its share of the weighted solutions.
+*
+*	The components and the Cells away from the frontier are combined
+*	through the bombs that are left: a component using k bombs leaves
+*	the rest for the interior, which can hold them in C( interior, rest )
+*	ways. All weights are kept scaled so that no count overflows.
+*************************************************************************/
+#ifndef MINEPROBABILITY_H
+#define MINEPROBABILITY_H
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "Board.h"
+#include "CellGrid.h"
+
+class MineProbability
+{
+	public:
+		MineProbability();
+		void SetTimeBudget( double seconds );
+		void SetStepBudget( long long steps );
+		void Cancel();
+		bool Compute( const Board & board, std::vector<double> & grid );
+		bool Compute( const CellGrid & board, std::vector<double> & grid );
+		~MineProbability();
+
+	private:
+		// A run of weights indexed by bomb count, starting at lo
+		struct Weights
+		{
+			int lo;
+			std::vector<double> ways;
+		};
+
+		// The partial solutions after the first Cells of a component
+		struct Layer
+		{
+			std::vector<std::vector<unsigned char> > keys; // What each open number still needs
+			std::vector<Weights> states;
+			std::vector<int> next[2];                      // State reached with the next Cell safe / a bomb
+		};
+
+		struct Component
+		{
+			std::vector<int> cells;       // Frontier Cells, in the order they are walked
+			std::vector<int> constraints; // Numbers that touch them
+			Weights counts;               // Solutions by bomb count
+		};
+
+		bool BuildComponents( const CellGrid & board, std::vector<double> & grid );
+		void OrderCells( Component & component );
+		bool Forward( const Component & component, std::vector<Layer> & layers );
+		bool Backward( const Component & component, std::vector<Layer> & layers,
+					   const Weights & weight, std::vector<double> & grid );
+		bool OutOfTime();
+		double LogBinomial( int n, int k ) const;
+		static Weights Multiply( const Weights & a, const Weights & b );
+
+		// Numbers as lists of frontier Cells (by frontier number) and the
+		// bombs still missing among them
+		std::vector<std::vector<int> > m_constraint_cells;
+		std::vector<int> m_constraint_need;
+		std::vector<std::vector<int> > m_cell_constraints;
+		std::vector<int> m_frontier;     // Board index of each frontier Cell
+		std::vector<int> m_position;     // Place of each frontier Cell in its component's line
+		std::vector<Component> m_components;
+
+		double m_budget;
+		long long m_step_budget;
+		std::chrono::steady_clock::time_point m_deadline;
+		std::atomic<bool> m_cancel;
+		long long m_checks;              // Steps taken by this Compute()
+};
+
+#endif
@@ -1,6 +1,19 @@
 #include "Minesweeper.h"
 #include "Board.h"
+#include "Exception.h"
+#include "Journal.h"
+#include "NoGuessGenerator.h"
+#include "Renderer.h"
+#include "Solver.h"
+#include "Terminal.h"
+#include "Viewport.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <random>
+#include <sstream>
 
 using std::cout;
 using std::endl;
@@ -8,6 +21,13 @@ using std::cin;
 
 enum MENU{ BEGINNER = 1, INTERMEDIATE, EXPERT, QUIT };
 
+// Lines of the prompt area below the Board, each written in place
+enum PROMPT{ HINT_LINE, QUESTION_LINE, ERROR_LINE, PROMPT_LINES };
+
+// Most Cells PlayViewport() keeps in one block; a bigger Board keeps
+// them in tiles that are only made as play reaches them
+const long long MAX_DENSE_CELLS = 4096LL * 4096;
+
 /***************************************************************
 *   Purpose: This constructor instantiates the object.
 *            
@@ -15,9 +35,49 @@ enum MENU{ BEGINNER = 1, INTERMEDIATE, EXPERT, QUIT };
 *            
 *      Exit: None
 ****************************************************************/
-Minesweeper::Minesweeper()
+Minesweeper::Minesweeper() : m_no_guess( false ), m_hints( false ), m_record_path( nullptr ),
+							 m_renderer( nullptr )
+{ }
+
+/***************************************************************
+*   Purpose: This constructor instantiates the object and chooses
+*			 whether boards must be solvable without guessing.
+*
+*     Entry: True to generate no-guess boards.
+*
+*      Exit: None
+****************************************************************/
+Minesweeper::Minesweeper( bool no_guess ) : m_no_guess( no_guess ), m_hints( false ),
+											 m_record_path( nullptr ), m_renderer( nullptr )
 { }
 
+/***************************************************************
+*   Purpose: Chooses a file to record each game into. Every game
+*			 replaces the journal of the one before it.
+*
+*     Entry: The path of the journal, or nullptr to stop recording.
+*
+*      Exit: None
+****************************************************************/
+void Minesweeper::SetRecordPath( const char * path )
+{
+	m_record_path = path;
+}
+
+/***************************************************************
+*   Purpose: Chooses whether the game shows a Cell the Solver has
+*			 proven safe before every move. Hints are off unless
+*			 this turns them on.
+*
+*     Entry: True to show hints.
+*
+*      Exit: None
+****************************************************************/
+void Minesweeper::SetHints( bool hints )
+{
+	m_hints = hints;
+}
+
 /***************************************************************
 *   Purpose: This method is what gets input from the user as to 
 *			 their choice in the main menu and gets the game going.
@@ -54,7 +114,10 @@ void Minesweeper::StartGame()
 ****************************************************************/
 void Minesweeper::DisplayMenu()
 {
-	system( "cls" );
+	Terminal terminal;
+
+	terminal.Clear();
+	terminal.Flush();
 
 	cout << "WELCOME TO MINESWEEPER" << endl;
 
@@ -117,26 +180,456 @@ void Minesweeper::ProcessMenuChoice( int choice )
 ****************************************************************/
 void Minesweeper::ProcessGame( int row, int col, int num_bombs )
 {
-	bool loss = false;
-	int  num_covered = 0;
-
 	Board game( row, col, num_bombs );
-	game.PlaceBombs();
-	game.DisplayBoard();
+	Renderer renderer;
+	Solver solver;
+	Journal journal;
+	int hint_row = -1;
+	int hint_col = -1;
+
+	if( m_record_path != nullptr && journal.Open( m_record_path ) )
+		game.SetJournal( &journal );
+
+	m_renderer = &renderer;
 
-	while( loss == false && num_covered != num_bombs )
+	if( m_no_guess )
 	{
-		loss = PlayGame( game );
-		num_covered = game.DisplayBoard();
+		renderer.Draw( game );
+		PlayFirstMove( game );
+		Redraw( game );
+	}
+	else
+	{
+		game.PlaceBombs();
+		renderer.Draw( game );
 	}
 
-	if( loss == true )
-		cout << "\n\nSorry, you have hit a bomb.\n" << endl;
+	if( m_hints )
+		solver.Attach( game );
+
+	while( game.IsLost() == false && game.IsWon() == false )
+	{
+		if( m_hints )
+			ShowHint( game, solver, hint_row, hint_col );
+
+		PlayGame( game );
 
-	if( num_covered == num_bombs )
+		if( m_hints )
+			solver.Update();
+
+		Redraw( game );
+	}
+
+	m_renderer = nullptr;
+
+	if( game.IsLost() )
+		cout << "\n\nSorry, you have hit a bomb.\n" << endl;
+	else
 		cout << "\n\nCongratulations! You win!\n" << endl;
 
-	system( "pause" );
+	cout << "Board seed: " << game.GetSeed() << '\n' << endl;
+
+	game.SetJournal( nullptr );
+	journal.Finish( game );
+
+	Terminal terminal;
+
+	terminal.Pause();
+}
+
+/***************************************************************
+*   Purpose: Plays a game from a script of moves instead of the
+*			 prompts. The whole script is read in one go and then
+*			 split into moves in a single pass: a move is the row,
+*			 column and action characters that would be typed at
+*			 the prompts (such as "C4U" or "c 4 f"), whitespace
+*			 between moves is ignored and a '#' starts a comment
+*			 that runs to the end of the line. Moves that are not
+*			 on the Board or have an unknown action are skipped, and
+*			 the script stops once the game is over.
+*
+*     Entry: The path of the script ("-" for standard input), the
+*			 size of the Board, the seed for its bombs and how many
+*			 moves to make between frames (0 to draw only the end).
+*
+*      Exit: The final Board and a summary are displayed. Returns
+*			 false if the script could not be read.
+****************************************************************/
+bool Minesweeper::PlayScript( const char * path, int row, int col, int num_bombs,
+							  unsigned long long seed, int render_every )
+{
+	std::string script;
+	Board game( row, col, num_bombs );
+	Renderer renderer;
+	Journal journal;
+	long long applied = 0;
+	long long skipped = 0;
+	long long frames = 0;
+	long long frame_bytes = 0;
+	long long frame_writes = 0;
+	size_t i = 0;
+
+	if( ReadScript( path, script ) == false )
+		return false;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if( m_record_path != nullptr && journal.Open( m_record_path ) )
+		game.SetJournal( &journal );
+
+	game.PlaceBombs( seed );
+
+	const char * text = script.c_str();
+	const size_t length = script.size();
+
+	while( i < length && game.IsLost() == false && game.IsWon() == false )
+	{
+		char move[3];
+		int  found = 0;
+
+		while( i < length && found < 3 )
+		{
+			const char letter = text[i++];
+
+			if( letter == '#' )
+			{
+				while( i < length && text[i] != '\n' )
+					++i;
+			}
+			else if( isspace( static_cast<unsigned char>( letter ) ) == false )
+				move[found++] = letter;
+		}
+
+		if( found < 3 )
+			break;
+
+		const int r = game.ConvertCoords( static_cast<char>( toupper( move[0] ) ) );
+		const int c = game.ConvertCoords( static_cast<char>( toupper( move[1] ) ) );
+		const char action = static_cast<char>( toupper( move[2] ) );
+
+		if( r < 0 || r >= game.GetRows() || c < 0 || c >= game.GetCols() ||
+			( action != 'U' && action != 'F' && action != 'C' ) )
+		{
+			skipped++;
+			continue;
+		}
+
+		game.ProcessCells( move[0], move[1], action );
+		applied++;
+
+		if( render_every > 0 && applied % render_every == 0 )
+		{
+			renderer.Draw( game );
+			frames++;
+			frame_bytes += renderer.GetFrameBytes();
+			frame_writes += renderer.GetFrameWrites();
+		}
+	}
+
+	game.SetJournal( nullptr );
+	journal.Finish( game );
+	renderer.Draw( game );
+	frames++;
+	frame_bytes += renderer.GetFrameBytes();
+	frame_writes += renderer.GetFrameWrites();
+
+	const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+	cout << "\n\nMoves applied:    " << applied << '\n'
+		 << "Moves skipped:    " << skipped << '\n'
+		 << "Result:           " << ( game.IsLost() ? "lost" : ( game.IsWon() ? "won" : "not finished" ) ) << '\n'
+		 << "Time:             " << seconds << " seconds\n"
+		 << "Moves/second:     " << ( seconds > 0 ? applied / seconds : 0 ) << '\n'
+		 << "Frames drawn:     " << frames << '\n'
+		 << "Bytes/frame:      " << frame_bytes / frames << '\n'
+		 << "Writes/frame:     " << static_cast<double>( frame_writes ) / frames << '\n'
+		 << "Board seed:       " << game.GetSeed() << endl;
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Reads a whole script into memory with one read of the
+*			 stream's buffer rather than a character at a time.
+*
+*     Entry: The path of the script, or "-" for standard input.
+*
+*      Exit: Returns false if the file could not be opened.
+****************************************************************/
+bool Minesweeper::ReadScript( const char * path, std::string & script )
+{
+	std::ostringstream contents;
+
+	try
+	{
+		if( strcmp( path, "-" ) == 0 )
+			contents << cin.rdbuf();
+		else
+		{
+			std::ifstream file( path, std::ios::binary );
+
+			if( file.is_open() == false )
+				throw Exception( "ERROR: Could not open the script" );
+
+			contents << file.rdbuf();
+		}
+	}
+	catch( Exception Error )
+	{
+		cout << Error << endl;
+		return false;
+	}
+
+	script = contents.str();
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Plays a game on a Board of any size with the keys
+*			 instead of the prompts. Only the part of the Board that
+*			 fits on the screen is drawn, around a cursor moved with
+*			 the arrow keys or h, j, k and l; the page keys move a
+*			 screen at a time and home and end go to the ends of
+*			 the row. U or space uncovers the Cell under the cursor,
+*			 F toggles its flag, C chords it and Q quits. The bombs
+*			 are placed on the first uncover, away from that Cell.
+*			 A Board of more than MAX_DENSE_CELLS is chunked, with
+*			 the same density of bombs in each tile, so its memory
+*			 grows with the area explored.
+*
+*     Entry: The size of the Board and the seed for its bombs (0
+*			 to pick one at random).
+*
+*      Exit: The game is over or was quit, and the result and seed
+*			 are displayed.
+****************************************************************/
+void Minesweeper::PlayViewport( int row, int col, int num_bombs, unsigned long long seed )
+{
+	const double cells = static_cast<double>( row ) * col;
+	Board game;
+	Viewport view;
+	Terminal terminal;
+	Journal journal;
+	bool placed = false;
+	int  lines = 24;
+	int  columns = 80;
+	int  key = 0;
+
+	if( seed == 0 )
+	{
+		std::random_device device;
+
+		seed = ( static_cast<unsigned long long>( device() ) << 32 ) ^ device();
+	}
+
+	if( cells > MAX_DENSE_CELLS )
+	{
+		const double tile_bombs = num_bombs * ( ChunkedArray2D<Cell>::TILE_CELLS / cells );
+
+		game.ResetChunked( row, col, std::min( static_cast<int>( tile_bombs + 0.5 ),
+											   ChunkedArray2D<Cell>::TILE_CELLS - 9 ) );
+	}
+	else
+		game.Reset( row, col, num_bombs );
+
+	if( m_record_path != nullptr && journal.Open( m_record_path ) )
+		game.SetJournal( &journal );
+
+	terminal.SetRawInput( true );
+	view.SetCursor( row / 2, col / 2 );
+	view.SetMessage( "Keys: arrows, U, F, C, Q" );
+
+	while( game.IsLost() == false && game.IsWon() == false )
+	{
+		char action = '\0';
+
+		// The screen can be resized at any time
+		terminal.GetSize( lines, columns );
+		view.SetScreenSize( lines, columns );
+		view.Draw( game );
+
+		key = terminal.ReadKey();
+
+		if( key == Terminal::KEY_NONE || key == 'q' || key == 'Q' )
+			break;
+
+		if( key == Terminal::KEY_UP || key == 'k' )
+			view.MoveCursor( -1, 0 );
+		else if( key == Terminal::KEY_DOWN || key == 'j' )
+			view.MoveCursor( 1, 0 );
+		else if( key == Terminal::KEY_LEFT || key == 'h' )
+			view.MoveCursor( 0, -1 );
+		else if( key == Terminal::KEY_RIGHT || key == 'l' )
+			view.MoveCursor( 0, 1 );
+		else if( key == Terminal::KEY_PAGE_UP )
+			view.MoveCursor( -view.GetViewRows(), 0 );
+		else if( key == Terminal::KEY_PAGE_DOWN )
+			view.MoveCursor( view.GetViewRows(), 0 );
+		else if( key == Terminal::KEY_HOME )
+			view.MoveCursor( 0, -col );
+		else if( key == Terminal::KEY_END )
+			view.MoveCursor( 0, col );
+		else if( key == ' ' )
+			action = 'U';
+		else if( key > 0 && key < 256 && strchr( "UFC", toupper( key ) ) != nullptr )
+			action = static_cast<char>( toupper( key ) );
+
+		// Nothing but an uncover makes sense before the bombs are placed
+		if( action == 'U' && placed == false )
+		{
+			game.PlaceBombs( seed, view.GetCursorRow(), view.GetCursorCol() );
+			game.LabelRegions();
+			placed = true;
+		}
+
+		if( action != '\0' && placed )
+		{
+			game.ProcessCell( view.GetCursorRow(), view.GetCursorCol(), action );
+			view.SetMessage( nullptr );
+		}
+	}
+
+	if( game.IsLost() || game.IsWon() )
+	{
+		view.SetMessage( game.IsLost() ? "You hit a bomb. Press any key." :
+										 "You win! Press any key." );
+		view.Draw( game );
+		terminal.ReadKey();
+	}
+
+	terminal.SetRawInput( false );
+	game.SetJournal( nullptr );
+	journal.Finish( game );
+
+	terminal.Clear();
+	terminal.Flush();
+
+	cout << "Result:           " << ( game.IsLost() ? "lost" : ( game.IsWon() ? "won" : "quit" ) ) << '\n'
+		 << "Board seed:       " << seed << endl;
+}
+
+/***************************************************************
+*   Purpose: Gets the first Cell to uncover from the user, then
+*			 generates a board that can be solved without guessing
+*			 from that Cell and uncovers it. If no such board is
+*			 found an ordinary one is used instead.
+*
+*     Entry: A Board with no bombs placed yet.
+*
+*      Exit: The bombs are placed and the first Cell is uncovered.
+****************************************************************/
+void Minesweeper::PlayFirstMove( Board & game )
+{
+	char row = '\0';
+	char col = '\0';
+	int  convert_col = 0;
+	NoGuessGenerator generator( game.GetRows(), game.GetCols(), game.GetBombs() );
+	std::random_device device;
+	unsigned long long seed = device();
+
+	SelectRow( row, game );
+	SelectCol( col, convert_col, game );
+
+	const int r = game.ConvertCoords( static_cast<char>( toupper( row ) ) );
+	const int c = game.ConvertCoords( static_cast<char>( toupper( col ) ) );
+
+	if( r < 0 || r >= game.GetRows() || c < 0 || c >= game.GetCols() )
+	{
+		game.PlaceBombs();
+		game.ProcessCell( r, c, 'U' );
+		return;
+	}
+
+	PlacePrompt( HINT_LINE );
+	cout << "Generating a no-guess board...";
+
+	seed = ( seed << 32 ) ^ device();
+	generator.SetSeed( seed );
+
+	if( generator.Generate( r, c, game ).found == false )
+	{
+		PlacePrompt( HINT_LINE );
+		cout << "No no-guess board was found, so this one may need a guess.";
+		game.PlaceBombs( seed, r, c );
+	}
+
+	game.ProcessCell( r, c, 'U' );
+}
+
+/***************************************************************
+*   Purpose: Tells the player about a Cell that the Solver has
+*			 proven safe, if there is one. The same Cell is shown
+*			 until it has been uncovered.
+*
+*     Entry: The Board, its Solver and the last Cell that was shown
+*			 (-1 if none).
+*
+*      Exit: The hint is displayed and remembered.
+****************************************************************/
+void Minesweeper::ShowHint( const Board & game, Solver & solver, int & hint_row,
+							int & hint_col )
+{
+	if( hint_row < 0 || game.GetCell( hint_row, hint_col ).IsCovered() == false ||
+		game.GetCell( hint_row, hint_col ).IsFlagged() )
+	{
+		if( solver.NextSafe( hint_row, hint_col ) == false )
+		{
+			hint_row = -1;
+			hint_col = -1;
+		}
+	}
+
+	if( hint_row >= 0 )
+	{
+		PlacePrompt( HINT_LINE );
+		cout << "Hint: row " << static_cast<char>( 65 + hint_row ) << ", column ";
+
+		if( hint_col < 26 )
+			cout << static_cast<char>( 65 + hint_col );
+		else
+			cout << ( hint_col - 25 );
+
+		cout << " is safe.";
+	}
+}
+
+/***************************************************************
+*   Purpose: Draws the next frame of a game played at the
+*			 prompts. It only repaints what changed, unless the
+*			 screen is too short for the Board and the prompts,
+*			 which then scroll it.
+*
+*     Entry: The Board being played. ProcessGame() has set up the
+*			 Renderer.
+*
+*      Exit: The Board is on the screen and the cursor is at the
+*			 start of the prompt area.
+****************************************************************/
+void Minesweeper::Redraw( const Board & game )
+{
+	if( m_renderer->FitsScreen( PROMPT_LINES ) == false )
+		m_renderer->Invalidate();
+
+	m_renderer->Draw( game );
+}
+
+/***************************************************************
+*   Purpose: Gets ready to write one line of the prompts. While a
+*			 game is drawn the line is written in place below the
+*			 Board, so the Board never scrolls; otherwise the
+*			 prompt starts on a new line.
+*
+*     Entry: The PROMPT line to write.
+*
+*      Exit: The cursor is at the start of an empty line.
+****************************************************************/
+void Minesweeper::PlacePrompt( int line )
+{
+	if( m_renderer != nullptr )
+		m_renderer->MoveToPrompt( line );
+	else
+		cout << '\n';
 }
 
 /***************************************************************
@@ -156,8 +649,6 @@ bool Minesweeper::PlayGame( Board & difficulty )
 	char action = '\0';
 	int  convert_col = 0;
 
-	cout << '\n' << endl;
-
 	SelectRow(row, difficulty);
 	SelectCol(col, convert_col, difficulty);
 	SelectAction(action);
@@ -176,15 +667,18 @@ void Minesweeper::SelectRow(char & row, Board & difficulty)
 {
 	do
 	{
+		PlacePrompt( QUESTION_LINE );
 		cout << "Select row: ";
 		cin >> row;
 		cin.sync();
 		cin.clear();
 
+		PlacePrompt( ERROR_LINE );
+
 		if ((static_cast<int>(toupper(row)) - 65) < 0 ||
 			(static_cast<int>(toupper(row)) - 65) > difficulty.GetRows())
 		{
-			cout << "ERROR: Invalid input.\n" << endl;
+			cout << "ERROR: Invalid input.";
 		}
 
 	} while ((static_cast<int>(toupper(row)) - 65) < 0 ||
@@ -202,6 +696,7 @@ void Minesweeper::SelectCol(char & col, int & convert_col, Board & difficulty)
 {
 	do
 	{
+		PlacePrompt( QUESTION_LINE );
 		cout << "Select column: ";
 		cin >> col;
 		cin.sync();
@@ -212,8 +707,10 @@ void Minesweeper::SelectCol(char & col, int & convert_col, Board & difficulty)
 		else
 			convert_col = static_cast<int>(toupper(col)) - 23;
 
+		PlacePrompt( ERROR_LINE );
+
 		if (convert_col < 0 || convert_col > difficulty.GetCols())
-			cout << "ERROR: Invalid input.\n" << endl;
+			cout << "ERROR: Invalid input.";
 
 	} while (convert_col < 0 || convert_col > difficulty.GetCols());
 }
@@ -230,22 +727,24 @@ void Minesweeper::SelectAction(char & action)
 {
 	do
 	{
-		cout << "\nACTIONS:"
-			<< "\nU) Uncover"
-			<< "\nF) Toggle Flag"
-			<< "\n\nSelect an action: ";
+		PlacePrompt( QUESTION_LINE );
+		cout << "Select an action (U = Uncover, F = Toggle Flag, C = Chord): ";
 		cin >> action;
 		cin.sync();
 		cin.clear();
 
+		PlacePrompt( ERROR_LINE );
+
 		if (toupper(action) != 'U' &&
-			toupper(action) != 'F')
+			toupper(action) != 'F' &&
+			toupper(action) != 'C')
 		{
-			cout << "ERROR: Invalid input.\n" << endl;
+			cout << "ERROR: Invalid input.";
 		}
 
 	} while (toupper(action) != 'U' &&
-		toupper(action) != 'F');
+		toupper(action) != 'F' &&
+		toupper(action) != 'C');
 }
 
 /***************************************************************
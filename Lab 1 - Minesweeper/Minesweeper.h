@@ -4,8 +4,17 @@
 * CONSTRUCTORS:	
 *	Minesweeper()
 *		This constructor instantiates the object.
+*	Minesweeper( bool no_guess )
+*		Same as Minesweeper(), but if no_guess is true every board can be
+*		solved from the first click without guessing.
 *
 * METHODS:
+*	void SetRecordPath( const char * path )
+*		Records every game played into a Journal at the given path, which
+*		keeps the last game. nullptr stops recording.
+*	void SetHints( bool hints )
+*		Shows a Cell that is certainly safe before every move if hints is
+*		true. They are off by default.
 *	void StartGame()
 *		This method is what gets input from the user as to their choice in
 *		the main menu and gets the game going.
@@ -17,6 +26,24 @@
 *	void ProcessGame( int row, int col, int num_bombs )
 *		This method processes the game logistics such as whether or not
 *		they have won/lost, the number of cells and bombs to be placed, etc.
+*	bool PlayScript( const char * path, int row, int col, int num_bombs,
+*					 unsigned long long seed, int render_every )
+*		This method plays a game from a file of moves, or from standard
+*		input if the path is "-", without any prompts, drawing the Board
+*		only every render_every moves (0 means only at the end). Returns
+*		false if the moves could not be read.
+*	void PlayViewport( int row, int col, int num_bombs, unsigned long long seed )
+*		This method plays a game on a Board of any size, drawing only the
+*		part of it that fits on the screen around a cursor that is moved
+*		with the keys. A very big Board is chunked, so that only the area
+*		explored takes memory. A seed of 0 picks one at random.
+*	void PlayFirstMove( Board & game )
+*		This method gets the first Cell to uncover from the user and then
+*		generates a board that can be solved without guessing from there.
+*	void ShowHint( const Board & game, Solver & solver, int & hint_row,
+*				   int & hint_col )
+*		This method shows the player a Cell that is certainly safe, if the
+*		Solver has found one.
 *	bool PlayGame( Board & difficulty );
 *		This method displays the user's options for actually playing the game
 *		such as giving them the option to flag or uncover a selected space.
@@ -27,7 +54,11 @@
 #define MINESWEEPER_H
 
 #include <iostream>
+#include <string>
 #include "Board.h"
+#include "NoGuessGenerator.h"
+#include "Renderer.h"
+#include "Solver.h"
 
 using std::cout;
 using std::endl;
@@ -37,15 +68,34 @@ class Minesweeper
 {
 	public:
 		Minesweeper();
+		Minesweeper( bool no_guess );
+		void SetRecordPath( const char * path );
+		void SetHints( bool hints );
 		void StartGame();
 		void DisplayMenu();
 		void ProcessMenuChoice( int choice );
 		void ProcessGame( int row, int col, int num_bombs );
+		bool PlayScript( const char * path, int row, int col, int num_bombs,
+						 unsigned long long seed, int render_every );
+		void PlayViewport( int row, int col, int num_bombs, unsigned long long seed );
+		void PlayFirstMove( Board & game );
+		void ShowHint( const Board & game, Solver & solver, int & hint_row,
+					   int & hint_col );
 		bool PlayGame( Board & difficulty );
 		void SelectRow(char & row, Board & difficulty);
 		void SelectCol(char & col, int & convert_col, Board & difficulty);
 		void SelectAction(char & action);
 		~Minesweeper();
+
+	private:
+		static bool ReadScript( const char * path, std::string & script );
+		void Redraw( const Board & game );
+		void PlacePrompt( int line );
+
+		bool m_no_guess;
+		bool m_hints;               // Show a proven-safe Cell before each move
+		const char * m_record_path; // Journal to record into, or nullptr
+		Renderer * m_renderer;      // Draws the game being played at the prompts, or nullptr
 };
 
 #endif
\ No newline at end of file
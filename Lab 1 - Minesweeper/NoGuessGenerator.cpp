@@ -0,0 +1,294 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "NoGuessGenerator.h"
+
+using std::cout;
+using std::endl;
+
+// Most steps a single check may spend working out the odds. A count
+// rather than a time, so that whether a candidate passes does not
+// depend on the machine, its load or the number of threads
+const long long CHECK_STEPS = 1000000;
+
+/***************************************************************
+*   Purpose: Default constructor for NoGuessGenerator. Makes
+*			 Beginner boards on every available core.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+NoGuessGenerator::NoGuessGenerator() : m_rows( 10 ), m_cols( 10 ), m_bombs( 10 ),
+									   m_threads( 0 ), m_max_attempts( 1000000 ),
+									   m_seed( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Sets up a NoGuessGenerator that makes boards of the
+*			 given size.
+*
+*     Entry: The rows, columns and number of bombs of each Board.
+*
+*      Exit: None
+****************************************************************/
+NoGuessGenerator::NoGuessGenerator( int rows, int cols, int bombs ) : m_rows( rows ),
+																	  m_cols( cols ),
+																	  m_bombs( bombs ),
+																	  m_threads( 0 ),
+																	  m_max_attempts( 1000000 ),
+																	  m_seed( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Sets how many threads try candidates at once.
+*
+*     Entry: The number of threads. 0 means one thread per core.
+*
+*      Exit: None
+****************************************************************/
+void NoGuessGenerator::SetThreads( int threads )
+{
+	m_threads = threads;
+}
+
+/***************************************************************
+*   Purpose: Sets the seed that every candidate's seed is derived
+*			 from, so that a run can be repeated.
+*
+*     Entry: The seed for the run.
+*
+*      Exit: None
+****************************************************************/
+void NoGuessGenerator::SetSeed( unsigned long long seed )
+{
+	m_seed = seed;
+}
+
+/***************************************************************
+*   Purpose: Sets how many candidates may be tried before giving
+*			 up.
+*
+*     Entry: The number of candidates.
+*
+*      Exit: None
+****************************************************************/
+void NoGuessGenerator::SetMaxAttempts( long long attempts )
+{
+	m_max_attempts = attempts;
+}
+
+/***************************************************************
+*   Purpose: Finds a board that can be solved without guessing
+*			 from a first click on the given Cell, trying candidates
+*			 on all of the threads at once.
+*
+*     Entry: The row and column of the first click and the Board
+*			 to place the bombs on, which has no bombs yet.
+*
+*      Exit: If one was found, the Board holds its bombs, which the
+*			 seed in the results and the first click reproduce.
+*			 Returns the results of the run.
+****************************************************************/
+GenerationResults NoGuessGenerator::Generate( int row, int col, Board & board )
+{
+	std::atomic<long long> next_attempt( 0 );
+	std::atomic<long long> winner( m_max_attempts );
+	std::atomic<long long> attempts( 0 );
+	std::vector<std::thread> workers;
+	int threads = m_threads;
+
+	if( threads <= 0 )
+		threads = static_cast<int>( std::thread::hardware_concurrency() );
+
+	if( threads <= 0 )
+		threads = 1;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for( int i = 0; i < threads; ++i )
+	{
+		workers.push_back( std::thread( &NoGuessGenerator::TryCandidates, this, row, col,
+										std::ref( next_attempt ), std::ref( winner ),
+										std::ref( attempts ) ) );
+	}
+
+	for( int i = 0; i < threads; ++i )
+		workers[i].join();
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	GenerationResults results = GenerationResults();
+
+	results.found = ( winner < m_max_attempts );
+	results.seed = m_seed + static_cast<unsigned long long>( winner.load() );
+	results.attempts = attempts;
+	results.seconds = elapsed.count();
+	results.threads = threads;
+
+	if( results.found )
+	{
+		board.Reset( m_rows, m_cols, m_bombs );
+		board.PlaceBombs( results.seed, row, col );
+	}
+
+	return results;
+}
+
+/***************************************************************
+*   Purpose: Plays a Board from a first click without guessing:
+*			 takes every move the Solver proves, and when it is
+*			 stuck uncovers the Cells that MineProbability gives no
+*			 chance of being a bomb.
+*
+*     Entry: A Board with its bombs placed and nothing uncovered,
+*			 the first click and the Solver, odds engine and grid
+*			 to use.
+*
+*      Exit: Returns true if the Board was won. The Board is left
+*			 as far as it got.
+****************************************************************/
+bool NoGuessGenerator::IsSolvable( Board & board, int row, int col, Solver & solver,
+								   MineProbability & odds, std::vector<double> & grid )
+{
+	return Play( board, row, col, solver, odds, grid, nullptr, 0 );
+}
+
+/***************************************************************
+*   Purpose: Does the work of IsSolvable(), giving up early once
+*			 a lower numbered candidate has passed.
+*
+*     Entry: As IsSolvable(), plus the lowest candidate that has
+*			 passed so far (or nullptr) and this candidate's number.
+*
+*      Exit: Returns true if the Board was won.
+****************************************************************/
+bool NoGuessGenerator::Play( Board & board, int row, int col, Solver & solver,
+							 MineProbability & odds, std::vector<double> & grid,
+							 const std::atomic<long long> * winner, long long attempt )
+{
+	int r = 0;
+	int c = 0;
+
+	if( board.ProcessCell( row, col, 'U' ) )
+		return false;
+
+	solver.Attach( board );
+
+	while( board.IsWon() == false )
+	{
+		if( winner != nullptr && *winner < attempt )
+			return false;
+
+		solver.Update();
+
+		if( solver.NextSafe( r, c ) )
+		{
+			if( board.ProcessCell( r, c, 'U' ) )
+				return false;
+		}
+		else if( solver.NextMine( r, c ) )
+			board.ProcessCell( r, c, 'F' );
+		else
+		{
+			bool progress = false;
+
+			if( odds.Compute( board, grid ) == false )
+				return false;
+
+			for( int i = 0; i < static_cast<int>( grid.size() ); ++i )
+			{
+				const Cell & cell = board.GetCell( i / board.GetCols(), i % board.GetCols() );
+
+				if( grid[i] == 0 && cell.IsCovered() && cell.IsFlagged() == false )
+				{
+					if( board.ProcessCell( i / board.GetCols(), i % board.GetCols(), 'U' ) )
+						return false;
+
+					progress = true;
+				}
+			}
+
+			if( progress == false )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Prints the seed, the number of candidates tried and
+*			 the time it took to find the board.
+*
+*     Entry: The results returned by Generate().
+*
+*      Exit: The report is displayed to the console.
+****************************************************************/
+void NoGuessGenerator::Report( const GenerationResults & results )
+{
+	double per_second = 0;
+
+	if( results.seconds > 0 )
+		per_second = results.attempts / results.seconds;
+
+	if( results.found )
+		cout << "Board seed:       " << results.seed << '\n';
+	else
+		cout << "No board found.\n";
+
+	cout << "Threads:          " << results.threads << '\n'
+		 << "Attempts:         " << results.attempts << '\n'
+		 << "Time to board:    " << results.seconds << " seconds\n"
+		 << "Attempts/second:  " << per_second << endl;
+}
+
+/***************************************************************
+*   Purpose: The body of each worker thread. Claims candidate
+*			 numbers from the shared counter and checks them until
+*			 a lower numbered candidate has passed.
+*
+*     Entry: The first click, the shared counter, the lowest
+*			 candidate that has passed so far and the number of
+*			 candidates tried.
+*
+*      Exit: winner holds the lowest passing candidate this thread
+*			 found, if it is lower than the one already there.
+****************************************************************/
+void NoGuessGenerator::TryCandidates( int row, int col, std::atomic<long long> & next_attempt,
+									  std::atomic<long long> & winner,
+									  std::atomic<long long> & attempts ) const
+{
+	Board board( m_rows, m_cols, m_bombs );
+	Solver solver;
+	MineProbability odds;
+	std::vector<double> grid;
+	long long attempt = 0;
+
+	odds.SetStepBudget( CHECK_STEPS );
+
+	while( ( attempt = next_attempt.fetch_add( 1 ) ) < winner )
+	{
+		board.Reset( m_rows, m_cols, m_bombs );
+		board.PlaceBombs( m_seed + static_cast<unsigned long long>( attempt ), row, col );
+		attempts++;
+
+		if( Play( board, row, col, solver, odds, grid, &winner, attempt ) )
+		{
+			long long current = winner;
+
+			while( attempt < current && winner.compare_exchange_weak( current, attempt ) == false )
+			{ }
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+NoGuessGenerator::~NoGuessGenerator()
+{ }
@@ -0,0 +1,96 @@
+/************************************************************************
+* CLASS: NoGuessGenerator
+*
+* CONSTRUCTORS:
+*	NoGuessGenerator()
+*		Default constructor for NoGuessGenerator. Makes Beginner boards
+*		on every available core.
+*	NoGuessGenerator( int rows, int cols, int bombs )
+*		Sets up a NoGuessGenerator that makes boards of the given size.
+*
+* METHODS:
+*	void SetThreads( int threads )
+*		Sets how many threads try candidates at once. 0 means one thread
+*		per core.
+*	void SetSeed( unsigned long long seed )
+*		Sets the seed that every candidate's seed is derived from.
+*	void SetMaxAttempts( long long attempts )
+*		Sets how many candidates may be tried before giving up.
+*	GenerationResults Generate( int row, int col, Board & board )
+*		Finds a board that can be solved without guessing from a first
+*		click on the given Cell and places its bombs on the Board passed
+*		in. The results say how many candidates were tried and how long
+*		it took.
+*	static bool IsSolvable( Board & board, int row, int col, Solver & solver,
+*							MineProbability & odds, std::vector<double> & grid )
+*		Plays a Board from a first click without guessing. Returns true
+*		if it can be won that way.
+*	static void Report( const GenerationResults & results )
+*		Prints the seed, attempts and time to board of a run.
+*	~NoGuessGenerator()
+*		Destructs the object.
+*
+* NOTES:
+*	Candidates are made with Board::PlaceBombs() from the run seed plus
+*	the candidate's number, keeping the first click's 3x3 block clear.
+*	Each thread claims candidate numbers from a shared counter. When one
+*	passes, the threads stop claiming numbers above it and drop any
+*	higher candidate they are checking, but still finish the lower ones.
+*	The board returned is the lowest numbered one that passes, so a run
+*	gives the same board whatever the number of threads.
+*
+*	The check only makes moves that are certain: everything the Solver
+*	can prove, and then any Cell that MineProbability gives no chance at
+*	all of being a bomb. The odds are given a budget of steps rather
+*	than time, and a check that runs out fails, so whether a candidate
+*	passes depends only on its seed.
+*************************************************************************/
+#ifndef NOGUESSGENERATOR_H
+#define NOGUESSGENERATOR_H
+
+#include <atomic>
+#include <vector>
+#include "Board.h"
+#include "MineProbability.h"
+#include "Solver.h"
+
+struct GenerationResults
+{
+	bool      found;
+	unsigned long long seed;
+	long long attempts;
+	double    seconds;
+	int       threads;
+};
+
+class NoGuessGenerator
+{
+	public:
+		NoGuessGenerator();
+		NoGuessGenerator( int rows, int cols, int bombs );
+		void SetThreads( int threads );
+		void SetSeed( unsigned long long seed );
+		void SetMaxAttempts( long long attempts );
+		GenerationResults Generate( int row, int col, Board & board );
+		static bool IsSolvable( Board & board, int row, int col, Solver & solver,
+								MineProbability & odds, std::vector<double> & grid );
+		static void Report( const GenerationResults & results );
+		~NoGuessGenerator();
+
+	private:
+		static bool Play( Board & board, int row, int col, Solver & solver,
+						  MineProbability & odds, std::vector<double> & grid,
+						  const std::atomic<long long> * winner, long long attempt );
+		void TryCandidates( int row, int col, std::atomic<long long> & next_attempt,
+							std::atomic<long long> & winner,
+							std::atomic<long long> & attempts ) const;
+
+		int m_rows;
+		int m_cols;
+		int m_bombs;
+		int m_threads;
+		long long m_max_attempts;
+		unsigned long long m_seed;
+};
+
+#endif
@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <thread>
+#include "ParallelCascade.h"
+
+// Rows and columns of Cells in a tile
+const int CASCADE_TILE_SIZE = 256;
+
+// What one thread keeps while it floods a tile
+struct ParallelCascade::Work
+{
+	std::vector<int> seeds;       // The inbox of the tile being flooded
+	std::vector<int> stack;       // Blank Cells still to spread from
+	std::vector<int> posts[9];    // Cells over each edge and corner, by side
+	std::vector<int> changes;
+	long long uncovered;
+	long long unflagged;
+	long long revealed;
+	bool lost;
+};
+
+/***************************************************************
+*   Purpose: Sets up a cascade over the Cells of a Board kept in
+*			 row order.
+*
+*     Entry: The first Cell and the size of the board.
+*
+*      Exit: None
+****************************************************************/
+ParallelCascade::ParallelCascade( Cell * cells, int rows, int cols )
+	: m_cells( cells ), m_rows( rows ), m_cols( cols ),
+	  m_tile_rows( ( rows + CASCADE_TILE_SIZE - 1 ) / CASCADE_TILE_SIZE ),
+	  m_tile_cols( ( cols + CASCADE_TILE_SIZE - 1 ) / CASCADE_TILE_SIZE ),
+	  m_track( false ), m_working( 0 ), m_uncovered( 0 ), m_unflagged( 0 ),
+	  m_revealed( 0 ), m_lost( false )
+{ }
+
+/***************************************************************
+*   Purpose: Runs the cascade. The Cells to spread from are posted
+*			 to the inboxes of their tiles, then the threads flood
+*			 tiles until no inbox has anything left.
+*
+*     Entry: The indexes, ( row * columns ) + column, of blank
+*			 Cells that are already uncovered, the number of
+*			 threads (0 means one per core) and whether to keep the
+*			 Cells that are uncovered.
+*
+*      Exit: Every Cell the cascade reaches is uncovered and the
+*			 totals are set.
+****************************************************************/
+void ParallelCascade::Run( const std::vector<int> & spread, int threads, bool track )
+{
+	std::vector<std::thread> workers;
+
+	m_track = track;
+	m_tiles.assign( static_cast<size_t>( m_tile_rows ) * m_tile_cols, Tile() );
+	m_ready.clear();
+	m_working = 0;
+	m_uncovered = 0;
+	m_unflagged = 0;
+	m_revealed = 0;
+	m_lost = false;
+	m_changes.clear();
+
+	for( int index : spread )
+	{
+		Tile & tile = m_tiles[TileOf( index )];
+
+		tile.inbox.push_back( ~index );
+
+		if( tile.ready == false )
+		{
+			tile.ready = true;
+			m_ready.push_back( TileOf( index ) );
+		}
+	}
+
+	if( threads <= 0 )
+		threads = static_cast<int>( std::thread::hardware_concurrency() );
+
+	threads = std::max( 1, std::min( threads, static_cast<int>( m_tiles.size() ) ) );
+
+	for( int i = 0; i < threads - 1; ++i )
+		workers.push_back( std::thread( &ParallelCascade::RunWorker, this ) );
+
+	RunWorker();
+
+	for( std::thread & worker : workers )
+		worker.join();
+
+	m_tiles.clear();
+}
+
+/***************************************************************
+*   Purpose: Gets how many Cells were uncovered.
+****************************************************************/
+long long ParallelCascade::GetUncovered() const
+{
+	return m_uncovered;
+}
+
+/***************************************************************
+*   Purpose: Gets how many of the Cells uncovered were flagged.
+****************************************************************/
+long long ParallelCascade::GetUnflagged() const
+{
+	return m_unflagged;
+}
+
+/***************************************************************
+*   Purpose: Gets how many of the Cells uncovered were safe.
+****************************************************************/
+long long ParallelCascade::GetRevealed() const
+{
+	return m_revealed;
+}
+
+/***************************************************************
+*   Purpose: Returns true if a bomb was uncovered.
+****************************************************************/
+bool ParallelCascade::IsLost() const
+{
+	return m_lost;
+}
+
+/***************************************************************
+*   Purpose: Gets the Cells that were uncovered, if Run() was
+*			 asked to keep them. They are in no particular order.
+****************************************************************/
+const std::vector<int> & ParallelCascade::GetChanges() const
+{
+	return m_changes;
+}
+
+/***************************************************************
+*   Purpose: The loop of each thread: takes a tile that is ready,
+*			 floods it with the lock released, then hands on what
+*			 it found. A thread with nothing to do waits until a
+*			 tile is ready or every other thread is idle too.
+*
+*     Entry: None
+*
+*      Exit: No tile is ready and no thread is working.
+****************************************************************/
+void ParallelCascade::RunWorker()
+{
+	Work work;
+	std::unique_lock<std::mutex> lock( m_lock );
+
+	work.uncovered = 0;
+	work.unflagged = 0;
+	work.revealed = 0;
+	work.lost = false;
+
+	while( true )
+	{
+		m_wake.wait( lock, [this]() { return m_ready.empty() == false || m_working == 0; } );
+
+		if( m_ready.empty() )
+			break;
+
+		const int tile = m_ready.back();
+
+		m_ready.pop_back();
+		work.seeds.swap( m_tiles[tile].inbox );
+		m_working++;
+
+		lock.unlock();
+		FloodTile( tile, work );
+		lock.lock();
+
+		Finish( tile, work );
+		m_working--;
+
+		if( m_ready.empty() == false || m_working == 0 )
+			m_wake.notify_all();
+	}
+
+	m_uncovered += work.uncovered;
+	m_unflagged += work.unflagged;
+	m_revealed += work.revealed;
+	m_lost = m_lost || work.lost;
+	m_changes.insert( m_changes.end(), work.changes.begin(), work.changes.end() );
+}
+
+/***************************************************************
+*   Purpose: Floods one tile from its inbox. Cells inside the
+*			 tile are uncovered and spread from straight away;
+*			 Cells over its edge are only noted, by side, for
+*			 Finish() to post, since another thread may be working
+*			 on them.
+*
+*     Entry: The tile, with its inbox taken into work.seeds.
+*
+*      Exit: The seeds are used up and work.posts holds the Cells
+*			 for the tiles around it.
+****************************************************************/
+void ParallelCascade::FloodTile( int tile, Work & work )
+{
+	const int top = ( tile / m_tile_cols ) * CASCADE_TILE_SIZE;
+	const int left = ( tile % m_tile_cols ) * CASCADE_TILE_SIZE;
+	const int bottom = std::min( top + CASCADE_TILE_SIZE, m_rows );
+	const int right = std::min( left + CASCADE_TILE_SIZE, m_cols );
+
+	for( int seed : work.seeds )
+	{
+		if( seed < 0 )
+			work.stack.push_back( ~seed );
+		else
+			UncoverCell( seed, work );
+	}
+
+	work.seeds.clear();
+
+	while( work.stack.empty() == false )
+	{
+		const int index = work.stack.back();
+		const int r = index / m_cols;
+		const int c = index % m_cols;
+
+		work.stack.pop_back();
+
+		// Most Cells are away from the edges, where nothing needs
+		// sorting by side
+		if( r > top && r < bottom - 1 && c > left && c < right - 1 )
+		{
+			for( int nr = r - 1; nr <= r + 1; ++nr )
+				for( int nc = c - 1; nc <= c + 1; ++nc )
+					UncoverCell( ( nr * m_cols ) + nc, work );
+
+			continue;
+		}
+
+		for( int nr = r - 1; nr <= r + 1; ++nr )
+		{
+			if( nr < 0 || nr >= m_rows )
+				continue;
+
+			const int side_row = nr < top ? 0 : ( nr < bottom ? 1 : 2 );
+
+			for( int nc = c - 1; nc <= c + 1; ++nc )
+			{
+				if( nc < 0 || nc >= m_cols )
+					continue;
+
+				const int side = ( side_row * 3 ) + ( nc < left ? 0 : ( nc < right ? 1 : 2 ) );
+				const int neighbour = ( nr * m_cols ) + nc;
+
+				if( side == 4 )
+					UncoverCell( neighbour, work );
+				else
+				{
+					// Blank Cells along an edge share most of their
+					// neighbours over it
+					std::vector<int> & post = work.posts[side];
+
+					if( post.empty() || post.back() != neighbour )
+						post.push_back( neighbour );
+				}
+			}
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: Uncovers a Cell of the tile being flooded, keeping
+*			 it to spread from if it is blank.
+*
+*     Entry: The index of the Cell.
+*
+*      Exit: The Cell is uncovered and counted, if it was covered.
+****************************************************************/
+void ParallelCascade::UncoverCell( int index, Work & work )
+{
+	Cell & cell = m_cells[index];
+
+	if( cell.IsCovered() == false )
+		return;
+
+	if( cell.IsFlagged() )
+		work.unflagged++;
+
+	cell.Uncover();
+	work.uncovered++;
+
+	if( cell.IsBomb() )
+		work.lost = true;
+	else
+		work.revealed++;
+
+	if( m_track )
+		work.changes.push_back( index );
+
+	if( cell.IsBomb() == false && cell.GetNumBombs() == 0 )
+		work.stack.push_back( index );
+}
+
+/***************************************************************
+*   Purpose: Adds Cells to the inbox of a tile and makes the tile
+*			 ready if it was not already.
+*
+*     Entry: The lock is held. The tile and the Cells, all inside
+*			 it.
+*
+*      Exit: None
+****************************************************************/
+void ParallelCascade::Post( int tile, const std::vector<int> & cells )
+{
+	Tile & target = m_tiles[tile];
+
+	target.inbox.insert( target.inbox.end(), cells.begin(), cells.end() );
+
+	if( target.ready == false )
+	{
+		target.ready = true;
+		m_ready.push_back( tile );
+	}
+}
+
+/***************************************************************
+*   Purpose: Hands on what flooding a tile found: the Cells over
+*			 its edges go to the tiles around it, and the tile
+*			 itself is made ready again if Cells were posted to it
+*			 while it was being flooded.
+*
+*     Entry: The lock is held. The tile that was flooded.
+*
+*      Exit: work.posts is empty.
+****************************************************************/
+void ParallelCascade::Finish( int tile, Work & work )
+{
+	const int tile_row = tile / m_tile_cols;
+	const int tile_col = tile % m_tile_cols;
+
+	for( int side = 0; side < 9; ++side )
+	{
+		if( work.posts[side].empty() )
+			continue;
+
+		const int row = tile_row + ( side / 3 ) - 1;
+		const int col = tile_col + ( side % 3 ) - 1;
+
+		Post( ( row * m_tile_cols ) + col, work.posts[side] );
+		work.posts[side].clear();
+	}
+
+	if( m_tiles[tile].inbox.empty() )
+		m_tiles[tile].ready = false;
+	else
+		m_ready.push_back( tile );
+}
+
+/***************************************************************
+*   Purpose: Gets the tile that holds a Cell.
+*
+*     Entry: The index of the Cell.
+*
+*      Exit: Returns the index of the tile, in row order.
+****************************************************************/
+int ParallelCascade::TileOf( int index ) const
+{
+	const int row = index / m_cols;
+	const int col = index % m_cols;
+
+	return ( ( row / CASCADE_TILE_SIZE ) * m_tile_cols ) + ( col / CASCADE_TILE_SIZE );
+}
@@ -0,0 +1,93 @@
+/************************************************************************
+* CLASS: ParallelCascade
+*
+* CONSTRUCTORS:
+*	ParallelCascade( Cell * cells, int rows, int cols )
+*		Sets up a cascade over the Cells of a Board kept in row order.
+*
+* METHODS:
+*	void Run( const std::vector<int> & spread, int threads, bool track )
+*		Uncovers everything the cascade reaches from the blank, already
+*		uncovered Cells given by index, spread across the given number of
+*		threads (0 means one per core). If track is true the indexes of
+*		the Cells it uncovers are kept.
+*	long long GetUncovered() const
+*		Gets how many Cells were uncovered.
+*	long long GetUnflagged() const
+*		Gets how many of those were flagged.
+*	long long GetRevealed() const
+*		Gets how many of those were safe.
+*	bool IsLost() const
+*		Returns true if a bomb was uncovered.
+*	const std::vector<int> & GetChanges() const
+*		Gets the Cells that were uncovered, if they were kept, in no
+*		particular order.
+*
+* NOTES:
+*	The board is split into tiles of 256x256 Cells and a tile is only
+*	ever worked on by one thread at a time, so no Cell is shared. Each
+*	tile has an inbox of Cells to uncover; a thread takes a tile that
+*	has something in its inbox, floods it without crossing its edge, and
+*	posts the Cells just over the edge to the inboxes of the tiles next
+*	to it. When no tile has anything left and no thread is working the
+*	cascade is done. The Cells uncovered are exactly the ones the single
+*	threaded cascade in Board uncovers, since which Cells a cascade
+*	reaches does not depend on the order it visits them in.
+*************************************************************************/
+#ifndef PARALLELCASCADE_H
+#define PARALLELCASCADE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "Cell.h"
+
+class ParallelCascade
+{
+	public:
+		ParallelCascade( Cell * cells, int rows, int cols );
+		void Run( const std::vector<int> & spread, int threads, bool track );
+		long long GetUncovered() const;
+		long long GetUnflagged() const;
+		long long GetRevealed() const;
+		bool IsLost() const;
+		const std::vector<int> & GetChanges() const;
+
+	private:
+		struct Tile
+		{
+			std::vector<int> inbox; // Cells to uncover, or ~index of one to spread from
+			bool ready;             // In m_ready or being flooded
+		};
+
+		struct Work;
+
+		ParallelCascade( const ParallelCascade & copy );
+		ParallelCascade & operator=( const ParallelCascade & rhs );
+
+		void RunWorker();
+		void FloodTile( int tile, Work & work );
+		void UncoverCell( int index, Work & work );
+		void Post( int tile, const std::vector<int> & cells );
+		void Finish( int tile, Work & work );
+		int  TileOf( int index ) const;
+
+		Cell * m_cells;
+		int m_rows;
+		int m_cols;
+		int m_tile_rows;             // Tiles down the board
+		int m_tile_cols;             // Tiles across the board
+		bool m_track;
+		std::mutex m_lock;           // Guards everything below it
+		std::condition_variable m_wake;
+		std::vector<Tile> m_tiles;
+		std::vector<int> m_ready;    // Tiles waiting for a thread
+		int m_working;               // Threads flooding a tile now
+		long long m_uncovered;
+		long long m_unflagged;
+		long long m_revealed;
+		bool m_lost;
+		std::vector<int> m_changes;
+};
+
+#endif
@@ -0,0 +1,139 @@
+/************************************************************************
+* CLASS: Random
+*
+* CONSTRUCTORS:
+*	Random( unsigned long long seed = 0 )
+*		Seeds the generator with the value passed in.
+*
+* METHODS:
+*	void Seed( unsigned long long seed )
+*		Restarts the generator from a new seed. Every seed, including 0,
+*		gives its own sequence.
+*	unsigned long long Next()
+*		Returns the next 64 random bits.
+*	unsigned int NextBelow( unsigned int bound )
+*		Returns a random number from 0 up to, but not including, bound.
+*		Every number in the range is equally likely.
+*
+* NOTES:
+*	This is the xoshiro256** generator. Its 256 bits of state are
+*	filled from the seed with splitmix64, so that nearby seeds (such as
+*	consecutive game numbers) still give unrelated sequences. It is
+*	small enough for every thread or Board to own one.
+*************************************************************************/
+#ifndef RANDOM_H
+#define RANDOM_H
+
+class Random
+{
+	public:
+		Random( unsigned long long seed = 0 );
+		void Seed( unsigned long long seed );
+		unsigned long long Next();
+		unsigned int NextBelow( unsigned int bound );
+
+	private:
+		static unsigned long long RotateLeft( unsigned long long x, int k );
+
+		unsigned long long m_state[4];
+};
+
+/***************************************************************
+*   Purpose: Seeds the generator with the value passed in.
+*
+*     Entry: The seed.
+*
+*      Exit: None
+****************************************************************/
+inline Random::Random( unsigned long long seed )
+{
+	Seed( seed );
+}
+
+/***************************************************************
+*   Purpose: Restarts the generator from a new seed by running
+*			 splitmix64 over it to fill the state.
+*
+*     Entry: The seed.
+*
+*      Exit: None
+****************************************************************/
+inline void Random::Seed( unsigned long long seed )
+{
+	for( int i = 0; i < 4; ++i )
+	{
+		seed += 0x9E3779B97F4A7C15ULL;
+
+		unsigned long long z = seed;
+
+		z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+		z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+		m_state[i] = z ^ ( z >> 31 );
+	}
+}
+
+/***************************************************************
+*   Purpose: Returns the next 64 random bits.
+*
+*     Entry: None
+*
+*      Exit: Returns the random bits.
+****************************************************************/
+inline unsigned long long Random::Next()
+{
+	const unsigned long long result = RotateLeft( m_state[1] * 5, 7 ) * 9;
+	const unsigned long long t = m_state[1] << 17;
+
+	m_state[2] ^= m_state[0];
+	m_state[3] ^= m_state[1];
+	m_state[1] ^= m_state[2];
+	m_state[0] ^= m_state[3];
+	m_state[2] ^= t;
+	m_state[3] = RotateLeft( m_state[3], 45 );
+
+	return result;
+}
+
+/***************************************************************
+*   Purpose: Returns a random number from 0 up to, but not
+*			 including, bound, without the bias of "rand() % bound".
+*			 The top 32 bits are scaled into the range with a
+*			 multiply, and the few products that would make some
+*			 numbers more likely than others are thrown away.
+*
+*     Entry: The bound, which must be greater than 0.
+*
+*      Exit: Returns the random number.
+****************************************************************/
+inline unsigned int Random::NextBelow( unsigned int bound )
+{
+	unsigned long long product = ( Next() >> 32 ) * bound;
+	unsigned int low = static_cast<unsigned int>( product );
+
+	if( low < bound )
+	{
+		const unsigned int threshold = ( 0u - bound ) % bound;
+
+		while( low < threshold )
+		{
+			product = ( Next() >> 32 ) * bound;
+			low = static_cast<unsigned int>( product );
+		}
+	}
+
+	return static_cast<unsigned int>( product >> 32 );
+}
+
+/***************************************************************
+*   Purpose: Rotates the bits of x to the left by k places.
+*
+*     Entry: The value and the number of places.
+*
+*      Exit: Returns the rotated value.
+****************************************************************/
+inline unsigned long long Random::RotateLeft( unsigned long long x, int k )
+{
+	return ( x << k ) | ( x >> ( 64 - k ) );
+}
+
+#endif
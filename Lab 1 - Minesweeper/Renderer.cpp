@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <cstring>
+#include "Renderer.h"
+
+// Most bytes a colour sequence, a number and a cursor move take
+const size_t MAX_COLOR_BYTES = Terminal::MAX_ANSI_COLOR_BYTES;
+const size_t MAX_NUMBER_BYTES = 11;
+const size_t MAX_CURSOR_BYTES = 2 + MAX_NUMBER_BYTES + 1 + MAX_NUMBER_BYTES + 1;
+
+// Most bytes repainting one changed Cell takes
+const size_t CHANGED_CELL_BYTES = MAX_CURSOR_BYTES + MAX_COLOR_BYTES + 1;
+
+// Clears the screen, then indents the column labels
+const char CLEAR_SCREEN[] = "\x1b[H\x1b[2J   ";
+
+// Clears below the Board and starts the status line
+const char STATUS_TEXT[] = "\x1b[J\nNumber still covered: ";
+
+// Most bytes the status line takes
+const size_t MAX_STATUS_BYTES = MAX_COLOR_BYTES + MAX_CURSOR_BYTES + ( sizeof( STATUS_TEXT ) - 1 ) +
+								MAX_NUMBER_BYTES + 1;
+
+// Screen position (1 based) of the first Cell
+const int FIRST_CELL_LINE = 3;
+const int FIRST_CELL_COLUMN = 4;
+
+/***************************************************************
+*   Purpose: Default constructor for Renderer. The first frame it
+*			 draws is always a full one. On Windows it turns on ANSI
+*			 sequence handling for the console.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Renderer::Renderer() : m_length( 0 ), m_changed_limit( 0 ), m_rows( 0 ), m_cols( 0 ),
+					   m_color( -1 ), m_num_covered( 0 ), m_writes( 0 ), m_full_redraw( true )
+{
+	m_terminal.EnableAnsi();
+}
+
+/***************************************************************
+*   Purpose: Builds the next frame for the Board and writes it to
+*			 the console with a single write.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: The screen shows the Board. Returns the number of
+*			 Cells still covered (flagged Cells count as covered).
+****************************************************************/
+int Renderer::Draw( const Board & board )
+{
+	BuildFrame( board );
+
+	const long long before = m_terminal.GetNumWrites();
+
+	m_terminal.Write( m_frame.data(), m_length );
+	m_writes = m_terminal.GetNumWrites() - before;
+
+	return m_num_covered;
+}
+
+/***************************************************************
+*   Purpose: Builds the next frame for the Board without writing
+*			 it anywhere. The frame is a full redraw if nothing has
+*			 been drawn yet, Invalidate() was called, the Board's
+*			 size changed or the changes would take more than a
+*			 full redraw, and only the changed Cells otherwise.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: Returns the size of the frame in bytes. GetFrame()
+*			 has it until the next call.
+****************************************************************/
+size_t Renderer::BuildFrame( const Board & board )
+{
+	m_length = 0;
+	m_num_covered = 0;
+
+	if( board.GetRows() != m_rows || board.GetCols() != m_cols )
+	{
+		Resize( board.GetRows(), board.GetCols() );
+		m_full_redraw = true;
+	}
+
+	if( m_full_redraw == false && BuildChangedCells( board ) == false )
+	{
+		m_length = 0;
+		m_num_covered = 0;
+		m_full_redraw = true;
+	}
+
+	if( m_full_redraw )
+		BuildFullFrame( board );
+
+	AppendStatus();
+	m_full_redraw = false;
+
+	return m_length;
+}
+
+/***************************************************************
+*   Purpose: Gets the frame last built.
+*
+*     Entry: None
+*
+*      Exit: Returns its first byte. GetFrameBytes() gives its
+*			 size.
+****************************************************************/
+const char * Renderer::GetFrame() const
+{
+	return m_frame.data();
+}
+
+/***************************************************************
+*   Purpose: Forgets what is on the screen so that the next frame
+*			 is a full redraw.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void Renderer::Invalidate()
+{
+	m_full_redraw = true;
+}
+
+/***************************************************************
+*   Purpose: Moves the cursor to a line of the prompt area, which
+*			 starts on the line after the status line, and clears
+*			 that line. Whatever is printed next is written there
+*			 in place, so the prompts never scroll the Board.
+*
+*     Entry: The line of the prompt area, starting at 0. A frame
+*			 has been drawn.
+*
+*      Exit: The cursor is at the start of the cleared line.
+****************************************************************/
+void Renderer::MoveToPrompt( int line )
+{
+	char move[MAX_CURSOR_BYTES + 4];
+	const int length = snprintf( move, sizeof( move ), "\x1b[%d;1H\x1b[K",
+								 FIRST_CELL_LINE + m_rows + 2 + line );
+
+	m_terminal.Write( move, static_cast<size_t>( length ) );
+}
+
+/***************************************************************
+*   Purpose: Tells whether the Board, its status line and a
+*			 prompt area of the given size fit on the screen, so
+*			 that writing the prompts cannot scroll it.
+*
+*     Entry: The number of lines of the prompt area. A frame has
+*			 been drawn.
+*
+*      Exit: Returns true if they fit, or if the size of the
+*			 screen is not known.
+****************************************************************/
+bool Renderer::FitsScreen( int prompt_lines ) const
+{
+	int lines = 0;
+	int columns = 0;
+
+	return m_terminal.GetSize( lines, columns ) == false ||
+		   lines >= FIRST_CELL_LINE + m_rows + 1 + prompt_lines;
+}
+
+/***************************************************************
+*   Purpose: Returns the number of covered Cells counted by the
+*			 last frame.
+*
+*     Entry: None
+*
+*      Exit: Returns the number of covered Cells.
+****************************************************************/
+int Renderer::GetNumCovered() const
+{
+	return m_num_covered;
+}
+
+/***************************************************************
+*   Purpose: Returns the size in bytes of the last frame.
+****************************************************************/
+size_t Renderer::GetFrameBytes() const
+{
+	return m_length;
+}
+
+/***************************************************************
+*   Purpose: Returns how many system calls the last Draw() took
+*			 to write its frame. It is 1 unless the system took
+*			 the frame a part at a time.
+****************************************************************/
+long long Renderer::GetFrameWrites() const
+{
+	return m_writes;
+}
+
+/***************************************************************
+*   Purpose: Sizes the buffers for a new size of Board. The frame
+*			 buffer holds the largest full frame, which is also the
+*			 most a frame of changes is let grow to.
+*
+*     Entry: The size of the Board.
+*
+*      Exit: No frame is built and every Cell counts as changed.
+****************************************************************/
+void Renderer::Resize( int rows, int cols )
+{
+	const size_t cells = static_cast<size_t>( rows ) * cols;
+	size_t size = 0;
+
+	m_rows = rows;
+	m_cols = cols;
+	m_previous.assign( cells, '\0' );
+	m_row.resize( cols );
+
+	// The clear and the column labels, each a letter or a number
+	size = MAX_COLOR_BYTES + ( sizeof( CLEAR_SCREEN ) - 1 ) + MAX_COLOR_BYTES +
+		   ( static_cast<size_t>( cols ) * ( MAX_NUMBER_BYTES + 1 ) ) + 1;
+
+	// Each row's colour, new line and label, then each Cell's
+	// colour, symbol and space
+	size += static_cast<size_t>( rows ) * ( MAX_COLOR_BYTES + 4 );
+	size += cells * ( MAX_COLOR_BYTES + 2 );
+
+	m_frame.resize( size + MAX_STATUS_BYTES );
+	m_changed_limit = size > CHANGED_CELL_BYTES ? size - CHANGED_CELL_BYTES : 0;
+}
+
+/***************************************************************
+*   Purpose: Clears the screen and draws the labels and every
+*			 Cell of the Board.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: The frame holds the whole Board.
+****************************************************************/
+void Renderer::BuildFullFrame( const Board & board )
+{
+	const CellGrid grid = board.GetGrid();
+
+	m_color = -1;
+	AppendColor( Terminal::DEFAULT );
+	Append( CLEAR_SCREEN, sizeof( CLEAR_SCREEN ) - 1 );
+	AppendColor( Terminal::LIGHT_BLUE );
+
+	for( int i = 0; i < m_cols; i++ )
+	{
+		if( ( 65 + i ) < 91 )
+			m_frame[m_length++] = static_cast<char>( 65 + i );
+		else
+			AppendNumber( i - 25 );
+
+		m_frame[m_length++] = ' ';
+	}
+
+	m_frame[m_length++] = '\n';
+
+	for( int r = 0; r < m_rows; r++ )
+	{
+		const unsigned char * states = GetStates( board, grid, r );
+		char * previous = &m_previous[static_cast<size_t>( r ) * m_cols];
+
+		AppendColor( Terminal::LIGHT_BLUE );
+		m_frame[m_length++] = '\n';
+		m_frame[m_length++] = static_cast<char>( 65 + r );
+		m_frame[m_length++] = ' ';
+		m_frame[m_length++] = ' ';
+
+		for( int c = 0; c < m_cols; c++ )
+		{
+			const Glyph & glyph = m_glyphs[states[c]];
+
+			AppendColor( glyph.color );
+			m_frame[m_length++] = glyph.symbol;
+			m_frame[m_length++] = ' ';
+			m_num_covered += glyph.covered;
+			previous[c] = glyph.symbol;
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: Repaints only the Cells whose symbol is different
+*			 from the one that was drawn last time.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: The frame holds a cursor move and symbol for every
+*			 changed Cell. Returns false, part way through, if the
+*			 changes would take more than a full frame.
+****************************************************************/
+bool Renderer::BuildChangedCells( const Board & board )
+{
+	const CellGrid grid = board.GetGrid();
+
+	for( int r = 0; r < m_rows; r++ )
+	{
+		const unsigned char * states = GetStates( board, grid, r );
+		char * previous = &m_previous[static_cast<size_t>( r ) * m_cols];
+
+		for( int c = 0; c < m_cols; c++ )
+		{
+			const Glyph & glyph = m_glyphs[states[c]];
+
+			m_num_covered += glyph.covered;
+
+			if( glyph.symbol != previous[c] )
+			{
+				if( m_length > m_changed_limit )
+					return false;
+
+				AppendCursor( FIRST_CELL_LINE + r, FIRST_CELL_COLUMN + ( 2 * c ) );
+				AppendColor( glyph.color );
+				m_frame[m_length++] = glyph.symbol;
+				previous[c] = glyph.symbol;
+			}
+		}
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Gets the state bytes of one row of Cells. They are
+*			 read straight from the Board unless it is chunked, when
+*			 they are copied into a buffer kept for the purpose.
+*
+*     Entry: The Board, its grid (empty if it is chunked) and the
+*			 row.
+*
+*      Exit: Returns the state of each Cell of the row.
+****************************************************************/
+const unsigned char * Renderer::GetStates( const Board & board, const CellGrid & grid, int row )
+{
+	if( grid.GetRows() > 0 )
+		return reinterpret_cast<const unsigned char *>( &grid.GetCell( row, 0 ) );
+
+	for( int c = 0; c < m_cols; c++ )
+		m_row[c] = reinterpret_cast<const unsigned char &>( board.GetCell( row, c ) );
+
+	return m_row.data();
+}
+
+/***************************************************************
+*   Purpose: Moves below the Board, clears whatever was printed
+*			 there last time and prints the number of covered Cells.
+*
+*     Entry: The Cells of the frame have been built.
+*
+*      Exit: The frame ends with the status line.
+****************************************************************/
+void Renderer::AppendStatus()
+{
+	AppendColor( Terminal::DEFAULT );
+	AppendCursor( FIRST_CELL_LINE + m_rows, 1 );
+	Append( STATUS_TEXT, sizeof( STATUS_TEXT ) - 1 );
+	AppendNumber( m_num_covered );
+	m_frame[m_length++] = '\n';
+}
+
+/***************************************************************
+*   Purpose: Adds an ANSI colour change to the frame, unless the
+*			 colour is already the one in use.
+*
+*     Entry: The Terminal::Color.
+*
+*      Exit: The frame is switched to that colour.
+****************************************************************/
+void Renderer::AppendColor( int color )
+{
+	if( color != m_color )
+	{
+		Append( Terminal::ANSI_COLORS[color].text, Terminal::ANSI_COLORS[color].length );
+		m_color = color;
+	}
+}
+
+/***************************************************************
+*   Purpose: Adds an ANSI cursor move to the frame.
+*
+*     Entry: The line and column to move to, both starting at 1.
+*
+*      Exit: None
+****************************************************************/
+void Renderer::AppendCursor( int line, int column )
+{
+	m_frame[m_length++] = '\x1b';
+	m_frame[m_length++] = '[';
+	AppendNumber( line );
+	m_frame[m_length++] = ';';
+	AppendNumber( column );
+	m_frame[m_length++] = 'H';
+}
+
+/***************************************************************
+*   Purpose: Adds a number to the frame in decimal.
+*
+*     Entry: The number.
+*
+*      Exit: None
+****************************************************************/
+void Renderer::AppendNumber( int number )
+{
+	char digits[12];
+	int  length = 0;
+	unsigned int value = static_cast<unsigned int>( number );
+
+	if( number < 0 )
+	{
+		m_frame[m_length++] = '-';
+		value = 0u - value;
+	}
+
+	do
+	{
+		digits[length++] = static_cast<char>( '0' + ( value % 10 ) );
+		value /= 10;
+	} while( value != 0 );
+
+	while( length > 0 )
+		m_frame[m_length++] = digits[--length];
+}
+
+/***************************************************************
+*   Purpose: Adds bytes to the frame.
+*
+*     Entry: The bytes and how many there are.
+*
+*      Exit: None
+****************************************************************/
+void Renderer::Append( const char * text, size_t length )
+{
+	memcpy( &m_frame[m_length], text, length );
+	m_length += length;
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Renderer::~Renderer()
+{ }
@@ -0,0 +1,110 @@
+/************************************************************************
+* CLASS: Renderer
+*
+* CONSTRUCTORS:
+*	Renderer()
+*		Default constructor for Renderer. The first frame it draws is
+*		always a full one.
+*
+* METHODS:
+*	int Draw( const Board & board )
+*		Builds the next frame for the Board and writes it to the console
+*		in one go. Returns the number of Cells still covered, the same as
+*		Board::DisplayBoard().
+*	size_t BuildFrame( const Board & board )
+*		Builds the next frame for the Board without writing it anywhere.
+*		Returns its size in bytes.
+*	const char * GetFrame() const
+*		Gets the frame last built.
+*	void Invalidate()
+*		Forgets what is on the screen so that the next frame is a full
+*		redraw. Used after something else has cleared or scrolled the
+*		screen.
+*	void MoveToPrompt( int line )
+*		Moves the cursor to a line of the prompt area below the status
+*		line and clears that line, so that prompts are written in place.
+*	bool FitsScreen( int prompt_lines )
+*		Returns false if the screen is too short for the last frame and
+*		the given number of prompt lines, so that the prompts scroll it.
+*	int GetNumCovered() const
+*		Returns the number of covered Cells counted by the last frame.
+*	size_t GetFrameBytes() const
+*		Returns the size in bytes of the last frame.
+*	long long GetFrameWrites() const
+*		Returns how many system calls the last Draw() took to write its
+*		frame.
+*	~Renderer()
+*		Destructs the object.
+*
+* NOTES:
+*	The Renderer remembers the symbol it last drew for every Cell. After
+*	the first frame it only moves the cursor to the Cells whose symbol
+*	changed and repaints those, using ANSI cursor and colour sequences.
+*	Colour changes are only sent when the colour actually changes. If so
+*	many Cells changed that the frame would be larger than a full one, a
+*	full one is drawn instead.
+*
+*	The frame buffer is sized once for each size of Board, to the most a
+*	full frame can take, and the symbol and colour of every Cell state
+*	are looked up in a GlyphTable. Once the first frame is drawn,
+*	building a frame allocates nothing and writing it is a single write.
+*
+*	The screen layout matches Board::DisplayBoard(): the column labels
+*	are on the first line, the first row of Cells is on the third line
+*	and every Cell takes two characters. Changed Cells are repainted at
+*	those lines of the screen, so nothing may scroll it between frames:
+*	prompts go in place on the lines below the status line through
+*	MoveToPrompt(), and if FitsScreen() says the screen is too short for
+*	them the next frame needs Invalidate().
+*************************************************************************/
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <cstddef>
+#include <vector>
+#include "Board.h"
+#include "GlyphTable.h"
+#include "Terminal.h"
+
+class Renderer
+{
+	public:
+		Renderer();
+		int  Draw( const Board & board );
+		size_t BuildFrame( const Board & board );
+		const char * GetFrame() const;
+		void Invalidate();
+		void MoveToPrompt( int line );
+		bool FitsScreen( int prompt_lines ) const;
+		int  GetNumCovered() const;
+		size_t GetFrameBytes() const;
+		long long GetFrameWrites() const;
+		~Renderer();
+
+	private:
+		void Resize( int rows, int cols );
+		void BuildFullFrame( const Board & board );
+		bool BuildChangedCells( const Board & board );
+		const unsigned char * GetStates( const Board & board, const CellGrid & grid, int row );
+		void AppendStatus();
+		void AppendColor( int color );
+		void AppendCursor( int line, int column );
+		void AppendNumber( int number );
+		void Append( const char * text, size_t length );
+
+		Terminal m_terminal;
+		GlyphTable m_glyphs;
+		std::vector<char> m_previous;    // Symbol last drawn for each Cell
+		std::vector<unsigned char> m_row; // States of one row of a chunked Board
+		std::vector<char> m_frame;
+		size_t m_length;                 // Bytes of m_frame in use
+		size_t m_changed_limit;          // Most a frame of changes may take
+		int  m_rows;
+		int  m_cols;
+		int  m_color;
+		int  m_num_covered;
+		long long m_writes;
+		bool m_full_redraw;
+};
+
+#endif
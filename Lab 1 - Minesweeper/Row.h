@@ -75,12 +75,12 @@ Row<T>::Row( const Array2D<T> & ra, int row ) : m_array2D( ra ), m_row( row )
 template<class T>
 const T & Row<T>::operator[]( int column ) const
 {
-	if( column < 0 || column > m_array2D.getColumn() )
+	if( column < 0 || column >= m_array2D.getColumn() )
 	{
 		throw Exception( "ERROR: Column out of bounds" );
 	}
 
-	return m_array2D.Select( m_row, column );
+	return m_array2D.SelectUnchecked( m_row, column );
 }
 
 /***************************************************************
@@ -94,12 +94,12 @@ const T & Row<T>::operator[]( int column ) const
 template<class T>
 T & Row<T>::operator[]( int column )
 {
-	if( column < 0 || column > m_array2D.getColumn() )
+	if( column < 0 || column >= m_array2D.getColumn() )
 	{
 		throw Exception( "ERROR: Column out of bounds" );
 	}
 
-	return const_cast<Array2D<T> &>(m_array2D).Select( m_row, column );
+	return const_cast<Array2D<T> &>(m_array2D).SelectUnchecked( m_row, column );
 }
 
 /***************************************************************
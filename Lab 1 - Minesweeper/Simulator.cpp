@@ -0,0 +1,341 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "FixedBoard.h"
+#include "Simulator.h"
+
+using std::cout;
+using std::endl;
+
+// Number of games a thread claims from the shared counter at a time
+const long long GAMES_PER_BLOCK = 64;
+
+// Most steps the automatic player spends working out the odds for a
+// guess. A count rather than a time, so that a seed always plays out
+// the same whatever the machine, its load or the number of threads
+const long long GUESS_STEPS = 100000;
+
+/***************************************************************
+*   Purpose: Default constructor for Simulator. Plays Beginner
+*			 games on every available core.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Simulator::Simulator() : m_rows( 10 ), m_cols( 10 ), m_bombs( 10 ),
+						 m_threads( 0 ), m_seed( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Sets up a Simulator that plays games on a Board of
+*			 the given size.
+*
+*     Entry: The rows, columns and number of bombs of each Board.
+*
+*      Exit: None
+****************************************************************/
+Simulator::Simulator( int rows, int cols, int bombs ) : m_rows( rows ),
+														m_cols( cols ),
+														m_bombs( bombs ),
+														m_threads( 0 ),
+														m_seed( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Sets how many threads the games are spread across.
+*
+*     Entry: The number of threads. 0 means one thread per core.
+*
+*      Exit: None
+****************************************************************/
+void Simulator::SetThreads( int threads )
+{
+	m_threads = threads;
+}
+
+/***************************************************************
+*   Purpose: Sets the seed that the seed of every game is derived
+*			 from, so that a whole run can be repeated.
+*
+*     Entry: The seed for the run.
+*
+*      Exit: None
+****************************************************************/
+void Simulator::SetSeed( unsigned long long seed )
+{
+	m_seed = seed;
+}
+
+/***************************************************************
+*   Purpose: Plays the given number of games without any console
+*			 I/O, spread across the requested number of threads.
+*
+*     Entry: The number of games to play.
+*
+*      Exit: Returns the totals for the whole run.
+****************************************************************/
+SimulationResults Simulator::Run( long long games )
+{
+	std::atomic<long long> next_game( 0 );
+	std::vector<std::thread> workers;
+	int threads = m_threads;
+
+	if( threads <= 0 )
+		threads = static_cast<int>( std::thread::hardware_concurrency() );
+
+	if( threads <= 0 )
+		threads = 1;
+
+	std::vector<SimulationResults> partial( threads, SimulationResults() );
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for( int i = 0; i < threads; ++i )
+	{
+		workers.push_back( std::thread( &Simulator::PlayGames, this, games,
+										std::ref( next_game ),
+										std::ref( partial[i] ) ) );
+	}
+
+	for( int i = 0; i < threads; ++i )
+		workers[i].join();
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	SimulationResults results = SimulationResults();
+
+	for( int i = 0; i < threads; ++i )
+	{
+		results.games += partial[i].games;
+		results.wins += partial[i].wins;
+		results.moves += partial[i].moves;
+	}
+
+	results.seconds = elapsed.count();
+	results.threads = threads;
+
+	return results;
+}
+
+/***************************************************************
+*   Purpose: Prints the win rate, moves per game and games per
+*			 second of a run.
+*
+*     Entry: The results returned by Run().
+*
+*      Exit: The report is displayed to the console.
+****************************************************************/
+void Simulator::Report( const SimulationResults & results )
+{
+	double win_rate = 0;
+	double moves_per_game = 0;
+	double games_per_second = 0;
+
+	if( results.games > 0 )
+	{
+		win_rate = 100.0 * results.wins / results.games;
+		moves_per_game = static_cast<double>( results.moves ) / results.games;
+	}
+
+	if( results.seconds > 0 )
+		games_per_second = results.games / results.seconds;
+
+	cout << "Games played:     " << results.games << '\n'
+		 << "Threads:          " << results.threads << '\n'
+		 << "Wins:             " << results.wins << " (" << win_rate << "%)\n"
+		 << "Moves per game:   " << moves_per_game << '\n'
+		 << "Elapsed seconds:  " << results.seconds << '\n'
+		 << "Games per second: " << games_per_second << endl;
+}
+
+/***************************************************************
+*   Purpose: The body of each worker thread. Makes the thread's
+*			 board, a FixedBoard if the size is a preset and a
+*			 Board otherwise, and plays its share of the games on
+*			 it.
+*
+*     Entry: The total number of games, the shared counter and the
+*			 totals for this thread.
+*
+*      Exit: The totals for this thread are filled in.
+****************************************************************/
+void Simulator::PlayGames( long long games, std::atomic<long long> & next_game,
+						   SimulationResults & totals ) const
+{
+	auto play = [&]( auto & board )
+	{
+		PlayGamesOn( board, games, next_game, totals );
+	};
+
+	if( DispatchFixedBoard( m_rows, m_cols, m_bombs, play ) == false )
+	{
+		Board board( m_rows, m_cols, m_bombs );
+
+		play( board );
+	}
+}
+
+/***************************************************************
+*   Purpose: Claims blocks of games from the shared counter until
+*			 all of them have been played, reusing one board and
+*			 Solver for all of the thread's games.
+*
+*			 Each game's bombs and guesses are seeded from the run
+*			 seed and the game's number, so the results do not
+*			 depend on which thread happened to play which game.
+*
+*     Entry: The thread's board, the total number of games, the
+*			 shared counter and the totals for this thread.
+*
+*      Exit: The totals for this thread are filled in.
+****************************************************************/
+template< class GameBoard >
+void Simulator::PlayGamesOn( GameBoard & board, long long games,
+							 std::atomic<long long> & next_game,
+							 SimulationResults & totals ) const
+{
+	std::mt19937 generator;
+	Solver solver;
+	MineProbability odds;
+	std::vector<double> grid;
+	long long first = 0;
+	long long moves = 0;
+
+	odds.SetStepBudget( GUESS_STEPS );
+
+	while( ( first = next_game.fetch_add( GAMES_PER_BLOCK ) ) < games )
+	{
+		long long last = first + GAMES_PER_BLOCK;
+
+		if( last > games )
+			last = games;
+
+		for( long long game = first; game < last; ++game )
+		{
+			const unsigned long long game_seed = m_seed + static_cast<unsigned long long>( game );
+
+			board.Reset( m_rows, m_cols, m_bombs );
+			board.PlaceBombs( game_seed );
+			generator.seed( static_cast<unsigned int>( game_seed ) ^ 0x9E3779B9u );
+
+			moves = 0;
+
+			if( PlayOneGame( board, solver, odds, grid, generator, moves ) )
+				totals.wins++;
+
+			totals.moves += moves;
+			totals.games++;
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: The built-in automatic player. Makes every move that
+*			 the Solver can prove, flagging proven bombs. When there
+*			 are none it uncovers the Cell least likely to be a
+*			 bomb, or a random covered Cell if the odds could not be
+*			 worked out within the step budget.
+*
+*     Entry: A Board or FixedBoard with its bombs placed, the
+*			 Solver and odds engine to use with a grid for the odds,
+*			 the generator used for guesses and the move counter.
+*
+*      Exit: Returns true if the game was won. The move counter
+*			 holds the number of actions that were taken.
+****************************************************************/
+template< class GameBoard >
+bool Simulator::PlayOneGame( GameBoard & board, Solver & solver, MineProbability & odds,
+							 std::vector<double> & grid, std::mt19937 & generator,
+							 long long & moves )
+{
+	const int rows = board.GetRows();
+	const int cols = board.GetCols();
+	std::uniform_int_distribution<int> random_row( 0, rows - 1 );
+	std::uniform_int_distribution<int> random_col( 0, cols - 1 );
+	const CellGrid cells = board.GetGrid();
+	bool loss = false;
+
+	board.TrackChanges( true );
+	solver.Attach( cells );
+
+	while( loss == false && board.IsWon() == false )
+	{
+		int r = 0;
+		int c = 0;
+
+		solver.Update( board.GetChangedCells() );
+		board.ClearChangedCells();
+
+		if( solver.NextSafe( r, c ) )
+			loss = board.ProcessCell( r, c, 'U' );
+		else if( solver.NextMine( r, c ) )
+			board.ProcessCell( r, c, 'F' );
+		else if( FindBestGuess( cells, odds, grid, r, c ) )
+			loss = board.ProcessCell( r, c, 'U' );
+		else
+		{
+			do
+			{
+				r = random_row( generator );
+				c = random_col( generator );
+			} while( board.GetCell( r, c ).IsCovered() == false ||
+					 board.GetCell( r, c ).IsFlagged() );
+
+			loss = board.ProcessCell( r, c, 'U' );
+		}
+
+		moves++;
+	}
+
+	return loss == false;
+}
+
+/***************************************************************
+*   Purpose: Finds the covered Cell that is least likely to be a
+*			 bomb. The first such Cell in row order wins a tie.
+*
+*     Entry: A view of the board, the odds engine, a grid to hold
+*			 the odds and where to store the row and column.
+*
+*      Exit: Returns false if the odds could not be worked out.
+****************************************************************/
+bool Simulator::FindBestGuess( const CellGrid & cells, MineProbability & odds,
+							   std::vector<double> & grid, int & row, int & col )
+{
+	const int cols = cells.GetCols();
+	int best = -1;
+
+	if( odds.Compute( cells, grid ) == false )
+		return false;
+
+	for( int i = 0; i < static_cast<int>( grid.size() ); ++i )
+	{
+		const Cell & cell = cells.GetCell( i / cols, i % cols );
+
+		if( cell.IsCovered() && cell.IsFlagged() == false &&
+			( best < 0 || grid[i] < grid[best] ) )
+		{
+			best = i;
+		}
+	}
+
+	if( best < 0 )
+		return false;
+
+	row = best / cols;
+	col = best % cols;
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Simulator::~Simulator()
+{ }
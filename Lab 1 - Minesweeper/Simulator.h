@@ -0,0 +1,91 @@
+/************************************************************************
+* CLASS: Simulator
+*
+* CONSTRUCTORS:
+*	Simulator()
+*		Default constructor for Simulator. Plays Beginner games on every
+*		available core.
+*	Simulator( int rows, int cols, int bombs )
+*		Sets up a Simulator that plays games on a Board of the given size.
+*
+* METHODS:
+*	void SetThreads( int threads )
+*		Sets how many threads the games are spread across. 0 means one
+*		thread per core.
+*	void SetSeed( unsigned long long seed )
+*		Sets the seed that the seed of every game is derived from, so a
+*		whole run can be repeated.
+*	SimulationResults Run( long long games )
+*		Plays the given number of games without any console I/O and
+*		returns the totals.
+*	static void Report( const SimulationResults & results )
+*		Prints the win rate, moves per game and games per second of a run.
+*	~Simulator()
+*		Destructs the object.
+*
+* NOTES:
+*	Every thread owns its Board and its random number generator, and the
+*	games are handed out in blocks through a shared counter, so threads
+*	never wait on each other while a game is being played.
+*
+*	The automatic player makes every move the Solver can prove and only
+*	guesses when there are none, picking the Cell that MineProbability
+*	says is least likely to be a bomb.
+*
+*	Games of the preset sizes are played on a FixedBoard picked by
+*	DispatchFixedBoard(), and any other size on a Board. Both give the
+*	same boards for the same seeds, so the results are the same.
+*************************************************************************/
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <atomic>
+#include <random>
+#include <vector>
+#include "Board.h"
+#include "CellGrid.h"
+#include "MineProbability.h"
+#include "Solver.h"
+
+struct SimulationResults
+{
+	long long games;
+	long long wins;
+	long long moves;
+	double    seconds;
+	int       threads;
+};
+
+class Simulator
+{
+	public:
+		Simulator();
+		Simulator( int rows, int cols, int bombs );
+		void SetThreads( int threads );
+		void SetSeed( unsigned long long seed );
+		SimulationResults Run( long long games );
+		static void Report( const SimulationResults & results );
+		~Simulator();
+
+	private:
+		void PlayGames( long long games, std::atomic<long long> & next_game,
+						SimulationResults & totals ) const;
+		template< class GameBoard >
+		void PlayGamesOn( GameBoard & board, long long games,
+						  std::atomic<long long> & next_game,
+						  SimulationResults & totals ) const;
+		template< class GameBoard >
+		static bool PlayOneGame( GameBoard & board, Solver & solver, MineProbability & odds,
+								 std::vector<double> & grid, std::mt19937 & generator,
+								 long long & moves );
+		static bool FindBestGuess( const CellGrid & cells, MineProbability & odds,
+								   std::vector<double> & grid, int & row, int & col );
+
+		int m_rows;
+		int m_cols;
+		int m_bombs;
+		int m_threads;
+		unsigned long long m_seed;
+};
+
+#endif
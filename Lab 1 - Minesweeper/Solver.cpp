@@ -0,0 +1,464 @@
+#include "Solver.h"
+
+// What the Solver has proven about a covered Cell
+const unsigned char UNKNOWN = 0;
+const unsigned char SAFE = 1;
+const unsigned char MINE = 2;
+
+/***************************************************************
+*   Purpose: Default constructor for Solver. It knows nothing
+*			 until a Board is attached.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Solver::Solver() : m_board( nullptr ), m_rows( 0 ), m_cols( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Starts solving the given Board. Turns on the Board's
+*			 change tracking so that Update() can see what changed,
+*			 and evaluates every number that is already visible.
+*
+*     Entry: The Board to solve, which must not be chunked. It must
+*			 outlive the Solver or the next Attach(), and must not
+*			 be reset or loaded in between.
+*
+*      Exit: Everything that can be proven from the visible Board
+*			 has been found.
+****************************************************************/
+void Solver::Attach( Board & board )
+{
+	board.TrackChanges( true );
+	Attach( board.GetGrid() );
+
+	m_board = &board;
+}
+
+/***************************************************************
+*   Purpose: Starts solving the board the grid shows. Nothing is
+*			 turned on: the caller passes the changed Cells to
+*			 Update( changes ) itself.
+*
+*     Entry: A view of the board. The board must outlive the Solver
+*			 or the next Attach().
+*
+*      Exit: Everything that can be proven from the visible board
+*			 has been found.
+****************************************************************/
+void Solver::Attach( const CellGrid & grid )
+{
+	m_board = nullptr;
+	m_grid = grid;
+	m_rows = grid.GetRows();
+	m_cols = grid.GetCols();
+
+	m_known.assign( m_rows * m_cols, UNKNOWN );
+	m_queued.assign( m_rows * m_cols, 0 );
+	m_queue.clear();
+	m_safe.clear();
+	m_mines.clear();
+
+	for( int r = 0; r < m_rows; ++r )
+	{
+		for( int c = 0; c < m_cols; ++c )
+		{
+			const Cell & cell = grid.GetCell( r, c );
+
+			if( cell.IsCovered() == false && cell.GetNumBombs() > 0 )
+			{
+				m_queued[( r * m_cols ) + c] = 1;
+				m_queue.push_back( ( r * m_cols ) + c );
+			}
+		}
+	}
+
+	Propagate();
+}
+
+/***************************************************************
+*   Purpose: Reads the Cells that changed on the Board since the
+*			 last call, queues the numbers around them and
+*			 re-evaluates only those.
+*
+*     Entry: A Board has been attached.
+*
+*      Exit: The Board's list of changed Cells is emptied.
+****************************************************************/
+void Solver::Update()
+{
+	if( m_board == nullptr )
+		return;
+
+	Update( m_board->GetChangedCells() );
+	m_board->ClearChangedCells();
+}
+
+/***************************************************************
+*   Purpose: Same as Update(), for a board attached through its
+*			 grid: the caller passes the Cells that changed.
+*
+*     Entry: The indexes, row * columns + column, of the Cells
+*			 that changed since the last update.
+*
+*      Exit: None
+****************************************************************/
+void Solver::Update( const std::vector<int> & changes )
+{
+	for( size_t i = 0; i < changes.size(); ++i )
+		QueueAround( changes[i] );
+
+	Propagate();
+}
+
+/***************************************************************
+*   Purpose: Gets a Cell that is certainly safe and still covered.
+*
+*     Entry: Where to store the row and column.
+*
+*      Exit: Returns false if no such Cell is known.
+****************************************************************/
+bool Solver::NextSafe( int & row, int & col )
+{
+	while( m_safe.empty() == false )
+	{
+		const int index = m_safe.back();
+		const Cell & cell = m_grid.GetCell( index / m_cols, index % m_cols );
+
+		m_safe.pop_back();
+
+		if( cell.IsCovered() && cell.IsFlagged() == false )
+		{
+			row = index / m_cols;
+			col = index % m_cols;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/***************************************************************
+*   Purpose: Gets a Cell that is certainly a bomb and has not been
+*			 flagged yet.
+*
+*     Entry: Where to store the row and column.
+*
+*      Exit: Returns false if no such Cell is known.
+****************************************************************/
+bool Solver::NextMine( int & row, int & col )
+{
+	while( m_mines.empty() == false )
+	{
+		const int index = m_mines.back();
+		const Cell & cell = m_grid.GetCell( index / m_cols, index % m_cols );
+
+		m_mines.pop_back();
+
+		if( cell.IsCovered() && cell.IsFlagged() == false )
+		{
+			row = index / m_cols;
+			col = index % m_cols;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/***************************************************************
+*   Purpose: Tells whether the Cell has been proven safe.
+*
+*     Entry: The row and column of a Cell on the Board.
+*
+*      Exit: Returns true if it is safe.
+****************************************************************/
+bool Solver::IsSafe( int row, int col ) const
+{
+	return m_known[( row * m_cols ) + col] == SAFE;
+}
+
+/***************************************************************
+*   Purpose: Tells whether the Cell has been proven to be a bomb.
+*
+*     Entry: The row and column of a Cell on the Board.
+*
+*      Exit: Returns true if it is a bomb.
+****************************************************************/
+bool Solver::IsMine( int row, int col ) const
+{
+	return m_known[( row * m_cols ) + col] == MINE;
+}
+
+/***************************************************************
+*   Purpose: Builds the constraint of an uncovered number: its
+*			 covered neighbours that are not flagged or proven yet,
+*			 and how many bombs are still missing among them.
+*
+*     Entry: The index of the Cell and the constraint to fill in.
+*
+*      Exit: Returns false if the Cell is not an uncovered number
+*			 or has no undecided neighbours.
+****************************************************************/
+bool Solver::GetConstraint( int index, Constraint & constraint ) const
+{
+	const int r = index / m_cols;
+	const int c = index % m_cols;
+	const Cell & cell = m_grid.GetCell( r, c );
+
+	if( cell.IsCovered() || cell.GetNumBombs() == 0 )
+		return false;
+
+	constraint.count = 0;
+	constraint.mines = cell.GetNumBombs();
+
+	for( int nr = r - 1; nr <= r + 1; ++nr )
+	{
+		if( nr < 0 || nr >= m_rows )
+			continue;
+
+		for( int nc = c - 1; nc <= c + 1; ++nc )
+		{
+			if( nc < 0 || nc >= m_cols )
+				continue;
+
+			const int neighbour = ( nr * m_cols ) + nc;
+			const Cell & other = m_grid.GetCell( nr, nc );
+
+			if( other.IsCovered() == false || m_known[neighbour] == SAFE )
+				continue;
+
+			if( other.IsFlagged() || m_known[neighbour] == MINE )
+				constraint.mines--;
+			else
+				constraint.cells[constraint.count++] = neighbour;
+		}
+	}
+
+	return constraint.count > 0;
+}
+
+/***************************************************************
+*   Purpose: Applies the rules to one number. First the number on
+*			 its own, then the number against every other number
+*			 close enough to share a neighbour with it.
+*
+*     Entry: The index of the Cell.
+*
+*      Exit: Anything proven is marked and the numbers around it
+*			 are queued. It stops as soon as something is found,
+*			 with this number queued again.
+****************************************************************/
+void Solver::Evaluate( int index )
+{
+	Constraint constraint;
+
+	if( GetConstraint( index, constraint ) == false || constraint.mines < 0 )
+		return;
+
+	if( constraint.mines == 0 )
+	{
+		for( int i = 0; i < constraint.count; ++i )
+			MarkSafe( constraint.cells[i] );
+
+		return;
+	}
+
+	if( constraint.mines == constraint.count )
+	{
+		for( int i = 0; i < constraint.count; ++i )
+			MarkMine( constraint.cells[i] );
+
+		return;
+	}
+
+	const int r = index / m_cols;
+	const int c = index % m_cols;
+	const size_t found = m_safe.size() + m_mines.size();
+
+	for( int nr = r - 2; nr <= r + 2; ++nr )
+	{
+		if( nr < 0 || nr >= m_rows )
+			continue;
+
+		for( int nc = c - 2; nc <= c + 2; ++nc )
+		{
+			const int other_index = ( nr * m_cols ) + nc;
+			Constraint other;
+
+			if( nc < 0 || nc >= m_cols || other_index == index ||
+				GetConstraint( other_index, other ) == false )
+			{
+				continue;
+			}
+
+			CompareSubset( constraint, other );
+			CompareSubset( other, constraint );
+
+			// The rest of the pairs are compared once this number's
+			// turn comes around again
+			if( m_safe.size() + m_mines.size() != found )
+			{
+				if( m_queued[index] == 0 )
+				{
+					m_queued[index] = 1;
+					m_queue.push_back( index );
+				}
+
+				return;
+			}
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: If every Cell of the small constraint is also in the
+*			 large one, the Cells only in the large one hold the
+*			 difference of their bombs. That decides them when the
+*			 difference is none or all of them.
+*
+*     Entry: The two constraints.
+*
+*      Exit: The Cells only in the large constraint are marked if
+*			 they are decided.
+****************************************************************/
+void Solver::CompareSubset( const Constraint & small, const Constraint & large )
+{
+	int rest[8];
+	int num_rest = 0;
+	int shared = 0;
+
+	if( small.count >= large.count )
+		return;
+
+	for( int i = 0; i < large.count; ++i )
+	{
+		bool in_small = false;
+
+		for( int j = 0; j < small.count && in_small == false; ++j )
+			in_small = ( small.cells[j] == large.cells[i] );
+
+		if( in_small )
+			shared++;
+		else
+			rest[num_rest++] = large.cells[i];
+	}
+
+	if( shared != small.count )
+		return;
+
+	if( large.mines == small.mines )
+	{
+		for( int i = 0; i < num_rest; ++i )
+			MarkSafe( rest[i] );
+	}
+	else if( large.mines - small.mines == num_rest )
+	{
+		for( int i = 0; i < num_rest; ++i )
+			MarkMine( rest[i] );
+	}
+}
+
+/***************************************************************
+*   Purpose: Records that a Cell is certainly safe.
+*
+*     Entry: The index of the Cell.
+*
+*      Exit: The Cell can be handed out by NextSafe() and the
+*			 numbers around it are queued.
+****************************************************************/
+void Solver::MarkSafe( int index )
+{
+	if( m_known[index] != UNKNOWN )
+		return;
+
+	m_known[index] = SAFE;
+	m_safe.push_back( index );
+	QueueAround( index );
+}
+
+/***************************************************************
+*   Purpose: Records that a Cell is certainly a bomb.
+*
+*     Entry: The index of the Cell.
+*
+*      Exit: The Cell can be handed out by NextMine() and the
+*			 numbers around it are queued.
+****************************************************************/
+void Solver::MarkMine( int index )
+{
+	if( m_known[index] != UNKNOWN )
+		return;
+
+	m_known[index] = MINE;
+	m_mines.push_back( index );
+	QueueAround( index );
+}
+
+/***************************************************************
+*   Purpose: Queues the uncovered numbers in the 3x3 block around
+*			 a Cell, the Cell itself included.
+*
+*     Entry: The index of the Cell.
+*
+*      Exit: Each number is on the queue at most once.
+****************************************************************/
+void Solver::QueueAround( int index )
+{
+	const int r = index / m_cols;
+	const int c = index % m_cols;
+
+	for( int nr = r - 1; nr <= r + 1; ++nr )
+	{
+		if( nr < 0 || nr >= m_rows )
+			continue;
+
+		for( int nc = c - 1; nc <= c + 1; ++nc )
+		{
+			if( nc < 0 || nc >= m_cols )
+				continue;
+
+			const int neighbour = ( nr * m_cols ) + nc;
+			const Cell & cell = m_grid.GetCell( nr, nc );
+
+			if( m_queued[neighbour] == 0 && cell.IsCovered() == false &&
+				cell.GetNumBombs() > 0 )
+			{
+				m_queued[neighbour] = 1;
+				m_queue.push_back( neighbour );
+			}
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: Evaluates queued numbers until the queue is empty.
+*
+*     Entry: None
+*
+*      Exit: Nothing more can be proven from the visible Board
+*			 with these rules.
+****************************************************************/
+void Solver::Propagate()
+{
+	while( m_queue.empty() == false )
+	{
+		const int index = m_queue.back();
+
+		m_queue.pop_back();
+		m_queued[index] = 0;
+
+		Evaluate( index );
+	}
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Solver::~Solver()
+{ }
@@ -0,0 +1,99 @@
+/************************************************************************
+* CLASS: Solver
+*
+* CONSTRUCTORS:
+*	Solver()
+*		Default constructor for Solver. It knows nothing until a Board is
+*		attached.
+*
+* METHODS:
+*	void Attach( Board & board )
+*		Starts solving the given Board. Turns on the Board's change
+*		tracking and reads everything that is already visible on it.
+*	void Attach( const CellGrid & grid )
+*		Same as Attach( Board & ), for any board that gives a CellGrid,
+*		such as a FixedBoard. Its changes are passed to Update( changes ).
+*	void Update()
+*		Reads the Cells that changed on the Board since the last call and
+*		re-evaluates only the numbers around them.
+*	void Update( const std::vector<int> & changes )
+*		Same as Update(), with the changed Cells given by the caller.
+*	bool NextSafe( int & row, int & col )
+*		Gets a Cell that is certainly safe and still covered. Returns
+*		false if there is none.
+*	bool NextMine( int & row, int & col )
+*		Gets a Cell that is certainly a bomb and is not flagged yet.
+*		Returns false if there is none.
+*	bool IsSafe( int row, int col ) const
+*		Returns true if the Cell has been proven safe.
+*	bool IsMine( int row, int col ) const
+*		Returns true if the Cell has been proven to be a bomb.
+*	~Solver()
+*		Destructs the object.
+*
+* NOTES:
+*	The Solver only reads what a player can see: the numbers of the
+*	uncovered Cells and the flags. Flags are trusted to be bombs.
+*
+*	Every uncovered number with covered neighbours is a constraint: so
+*	many of these Cells are bombs. A constraint that needs no more bombs
+*	makes all of its Cells safe, and one that needs all of them makes
+*	them all bombs. When the Cells of one constraint are a subset of
+*	another's within two Cells of it, the Cells left over hold the
+*	difference of the two numbers, which often decides them too.
+*
+*	Only the constraints next to a changed Cell are put on the work
+*	queue, so the cost of an Update() depends on how much changed, not on
+*	the size of the Board.
+*************************************************************************/
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <vector>
+#include "Board.h"
+#include "CellGrid.h"
+
+class Solver
+{
+	public:
+		Solver();
+		void Attach( Board & board );
+		void Attach( const CellGrid & grid );
+		void Update();
+		void Update( const std::vector<int> & changes );
+		bool NextSafe( int & row, int & col );
+		bool NextMine( int & row, int & col );
+		bool IsSafe( int row, int col ) const;
+		bool IsMine( int row, int col ) const;
+		~Solver();
+
+	private:
+		// The covered, unflagged and unproven Cells around a number,
+		// and how many of them are bombs
+		struct Constraint
+		{
+			int cells[8];
+			int count;
+			int mines;
+		};
+
+		bool GetConstraint( int index, Constraint & constraint ) const;
+		void Evaluate( int index );
+		void CompareSubset( const Constraint & small, const Constraint & large );
+		void MarkSafe( int index );
+		void MarkMine( int index );
+		void QueueAround( int index );
+		void Propagate();
+
+		Board * m_board;  // Only when attached to a Board
+		CellGrid m_grid;  // Where the Cells are read from
+		int m_rows;
+		int m_cols;
+		std::vector<unsigned char> m_known;  // UNKNOWN, SAFE or MINE for each Cell
+		std::vector<unsigned char> m_queued; // 1 if the Cell is on m_queue
+		std::vector<int> m_queue;            // Numbers waiting to be evaluated
+		std::vector<int> m_safe;             // Proven safe, not handed out yet
+		std::vector<int> m_mines;            // Proven bombs, not handed out yet
+};
+
+#endif
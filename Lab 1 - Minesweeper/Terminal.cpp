@@ -0,0 +1,486 @@
+#if defined( _WIN32 )
+#include <Windows.h>
+#include <conio.h>
+#else
+#include <errno.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+#include <stdio.h>
+#include <iostream>
+#include "Terminal.h"
+
+using std::cout;
+
+const Terminal::AnsiColor Terminal::ANSI_COLORS[] = { { "\x1b[0m", 4 }, { "\x1b[36m", 5 },
+													  { "\x1b[91m", 5 }, { "\x1b[92m", 5 },
+													  { "\x1b[93m", 5 }, { "\x1b[94m", 5 } };
+
+#if defined( _WIN32 )
+
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+
+// Console attribute of each Terminal::Color
+const WORD CONSOLE_COLORS[] = { 7, 3, 12, 10, 14, 9 };
+
+#else
+
+// Milliseconds to wait for the rest of a key sequence after an
+// escape, to tell the sequence from the escape key itself
+const int KEY_SEQUENCE_WAIT = 50;
+
+/***************************************************************
+*   Purpose: Reads one byte of input.
+*
+*     Entry: Where to put the byte and how many milliseconds to
+*			 wait for it (-1 waits for ever).
+*
+*      Exit: Returns false if no byte came in time or the input
+*			 has ended.
+****************************************************************/
+static bool ReadByte( unsigned char & byte, int wait )
+{
+	pollfd input = { STDIN_FILENO, POLLIN, 0 };
+	ssize_t got = 0;
+
+	if( wait >= 0 && poll( &input, 1, wait ) <= 0 )
+		return false;
+
+	while( ( got = read( STDIN_FILENO, &byte, 1 ) ) < 0 && errno == EINTR )
+		continue;
+
+	return got == 1;
+}
+
+#endif
+
+/***************************************************************
+*   Purpose: Default constructor for Terminal. Nothing is
+*			 buffered and the colour in use is not known, so the
+*			 first colour set is always sent.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Terminal::Terminal() : m_color( -1 ), m_writes( 0 ), m_saved_input( nullptr )
+{ }
+
+/***************************************************************
+*   Purpose: Clears the screen and moves the cursor to the top
+*			 left, without running a shell to do it.
+*
+*     Entry: None
+*
+*      Exit: On a POSIX terminal the clear is added to the frame;
+*			 on Windows the screen is cleared straight away.
+****************************************************************/
+void Terminal::Clear()
+{
+#if defined( _WIN32 )
+	HANDLE handle = GetStdHandle( STD_OUTPUT_HANDLE );
+	CONSOLE_SCREEN_BUFFER_INFO info;
+	COORD home = { 0, 0 };
+	DWORD written = 0;
+
+	Flush();
+
+	if( GetConsoleScreenBufferInfo( handle, &info ) )
+	{
+		const DWORD size = static_cast<DWORD>( info.dwSize.X ) * info.dwSize.Y;
+
+		FillConsoleOutputCharacterA( handle, ' ', size, home, &written );
+		FillConsoleOutputAttribute( handle, info.wAttributes, size, home, &written );
+		SetConsoleCursorPosition( handle, home );
+	}
+#else
+	m_frame += "\x1b[H\x1b[2J";
+#endif
+}
+
+/***************************************************************
+*   Purpose: Prints everything after it in the given colour. The
+*			 colour is only changed if it is not already in use.
+*
+*     Entry: The colour.
+*
+*      Exit: None
+****************************************************************/
+void Terminal::SetColor( Color color )
+{
+	if( color == m_color )
+		return;
+
+#if defined( _WIN32 )
+	Flush();
+	SetConsoleTextAttribute( GetStdHandle( STD_OUTPUT_HANDLE ), CONSOLE_COLORS[color] );
+#else
+	m_frame.append( ANSI_COLORS[color].text, ANSI_COLORS[color].length );
+#endif
+
+	m_color = color;
+}
+
+/***************************************************************
+*   Purpose: Adds text to the frame being built.
+*
+*     Entry: The text.
+*
+*      Exit: None
+****************************************************************/
+void Terminal::Print( const char * text )
+{
+	m_frame += text;
+}
+
+/***************************************************************
+*   Purpose: Adds one character to the frame being built.
+*
+*     Entry: The character.
+*
+*      Exit: None
+****************************************************************/
+void Terminal::Print( char letter )
+{
+	m_frame += letter;
+}
+
+/***************************************************************
+*   Purpose: Adds a number to the frame being built, in decimal.
+*
+*     Entry: The number.
+*
+*      Exit: None
+****************************************************************/
+void Terminal::Print( int number )
+{
+	char digits[16];
+
+	snprintf( digits, sizeof( digits ), "%d", number );
+	m_frame += digits;
+}
+
+/***************************************************************
+*   Purpose: Writes a whole frame that was built somewhere else
+*			 straight to the screen, after anything already
+*			 printed.
+*
+*     Entry: The frame and its length in bytes.
+*
+*      Exit: The frame is on the screen.
+****************************************************************/
+void Terminal::Write( const char * data, size_t length )
+{
+	Flush();
+	WriteOut( data, length );
+}
+
+/***************************************************************
+*   Purpose: Sends everything printed so far to the screen. What
+*			 went through cout is sent first so the two stay in
+*			 order.
+*
+*     Entry: None
+*
+*      Exit: The frame is empty, but keeps its memory for the
+*			 next one.
+****************************************************************/
+void Terminal::Flush()
+{
+	cout.flush();
+	fflush( stdout );
+
+	if( m_frame.empty() == false )
+	{
+		WriteOut( m_frame.data(), m_frame.size() );
+		m_frame.clear();
+	}
+}
+
+/***************************************************************
+*   Purpose: Waits for the player to press a key, the same as
+*			 system( "pause" ). On a POSIX terminal the key is read
+*			 in raw mode, so it does not need Enter after it and is
+*			 not echoed; keys typed before the prompt are thrown
+*			 away. If the input is not a terminal nothing is waited
+*			 for, since no one is there to press a key.
+*
+*     Entry: None
+*
+*      Exit: A key has been pressed.
+****************************************************************/
+void Terminal::Pause()
+{
+	Print( "Press any key to continue . . . " );
+	Flush();
+
+#if defined( _WIN32 )
+	_getch();
+#else
+	termios saved;
+
+	if( isatty( STDIN_FILENO ) && tcgetattr( STDIN_FILENO, &saved ) == 0 )
+	{
+		termios raw = saved;
+		char key = '\0';
+
+		// Ctrl+C still works, since ISIG is left on
+		raw.c_lflag &= ~( ICANON | ECHO | IEXTEN );
+		raw.c_cc[VMIN] = 1;
+		raw.c_cc[VTIME] = 0;
+
+		if( tcsetattr( STDIN_FILENO, TCSAFLUSH, &raw ) == 0 )
+		{
+			while( read( STDIN_FILENO, &key, 1 ) < 0 && errno == EINTR )
+				continue;
+
+			tcsetattr( STDIN_FILENO, TCSAFLUSH, &saved );
+		}
+	}
+#endif
+
+	Print( '\n' );
+	Flush();
+}
+
+/***************************************************************
+*   Purpose: Turns raw input on or off. While it is on, ReadKey()
+*			 gets each key as soon as it is pressed and keys are not
+*			 echoed. Ctrl+C still works. The Windows console needs
+*			 nothing turned on for that, and neither does input
+*			 that is not a terminal.
+*
+*     Entry: True to turn raw input on, false to put back the mode
+*			 from before.
+*
+*      Exit: None
+****************************************************************/
+void Terminal::SetRawInput( bool raw )
+{
+#if !defined( _WIN32 )
+	if( raw && m_saved_input == nullptr )
+	{
+		termios mode;
+
+		if( isatty( STDIN_FILENO ) == 0 || tcgetattr( STDIN_FILENO, &mode ) != 0 )
+			return;
+
+		termios * saved = new termios( mode );
+
+		mode.c_lflag &= ~( ICANON | ECHO | IEXTEN );
+		mode.c_cc[VMIN] = 1;
+		mode.c_cc[VTIME] = 0;
+
+		if( tcsetattr( STDIN_FILENO, TCSANOW, &mode ) == 0 )
+			m_saved_input = saved;
+		else
+			delete saved;
+	}
+	else if( raw == false && m_saved_input != nullptr )
+	{
+		termios * saved = static_cast<termios *>( m_saved_input );
+
+		tcsetattr( STDIN_FILENO, TCSANOW, saved );
+		delete saved;
+		m_saved_input = nullptr;
+	}
+#endif
+}
+
+/***************************************************************
+*   Purpose: Waits for a key, after sending what was printed so
+*			 far. The arrow, page, home and end keys arrive as
+*			 sequences of several bytes, which are turned into one
+*			 of the KEY_ values; sequences for other keys are
+*			 skipped.
+*
+*     Entry: None
+*
+*      Exit: Returns the key, or KEY_NONE if the input has ended.
+****************************************************************/
+int Terminal::ReadKey()
+{
+	Flush();
+
+	while( true )
+	{
+#if defined( _WIN32 )
+		const int key = _getch();
+
+		if( key != 0 && key != 224 )
+			return key;
+
+		switch( _getch() )
+		{
+			case 72: return KEY_UP;
+			case 80: return KEY_DOWN;
+			case 75: return KEY_LEFT;
+			case 77: return KEY_RIGHT;
+			case 73: return KEY_PAGE_UP;
+			case 81: return KEY_PAGE_DOWN;
+			case 71: return KEY_HOME;
+			case 79: return KEY_END;
+		}
+#else
+		unsigned char key = 0;
+		unsigned char kind = 0;
+		unsigned char code = 0;
+
+		if( ReadByte( key, -1 ) == false )
+			return KEY_NONE;
+
+		// An escape with nothing straight after it is the key itself
+		if( key != 0x1b || ReadByte( kind, KEY_SEQUENCE_WAIT ) == false )
+			return key;
+
+		if( ( kind != '[' && kind != 'O' ) || ReadByte( code, KEY_SEQUENCE_WAIT ) == false )
+			continue;
+
+		switch( code )
+		{
+			case 'A': return KEY_UP;
+			case 'B': return KEY_DOWN;
+			case 'C': return KEY_RIGHT;
+			case 'D': return KEY_LEFT;
+			case 'H': return KEY_HOME;
+			case 'F': return KEY_END;
+		}
+
+		// The rest are a number and a '~', such as "5~" for page up
+		if( code >= '0' && code <= '9' )
+		{
+			unsigned char next = 0;
+			int number = code - '0';
+
+			while( ReadByte( next, KEY_SEQUENCE_WAIT ) && next >= '0' && next <= '9' )
+				number = ( number * 10 ) + ( next - '0' );
+
+			if( next == '~' )
+			{
+				if( number == 5 )
+					return KEY_PAGE_UP;
+				if( number == 6 )
+					return KEY_PAGE_DOWN;
+				if( number == 1 || number == 7 )
+					return KEY_HOME;
+				if( number == 4 || number == 8 )
+					return KEY_END;
+			}
+		}
+#endif
+	}
+}
+
+/***************************************************************
+*   Purpose: Gets the size of the screen in characters.
+*
+*     Entry: Where to put the number of lines and columns.
+*
+*      Exit: Returns false, leaving them as they were, if the
+*			 output is not a screen.
+****************************************************************/
+bool Terminal::GetSize( int & lines, int & columns ) const
+{
+#if defined( _WIN32 )
+	CONSOLE_SCREEN_BUFFER_INFO info;
+
+	if( GetConsoleScreenBufferInfo( GetStdHandle( STD_OUTPUT_HANDLE ), &info ) == FALSE )
+		return false;
+
+	lines = info.srWindow.Bottom - info.srWindow.Top + 1;
+	columns = info.srWindow.Right - info.srWindow.Left + 1;
+#else
+	winsize size;
+
+	if( ioctl( STDOUT_FILENO, TIOCGWINSZ, &size ) != 0 || size.ws_row == 0 || size.ws_col == 0 )
+		return false;
+
+	lines = size.ws_row;
+	columns = size.ws_col;
+#endif
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Makes the screen understand ANSI cursor and colour
+*			 sequences. A POSIX terminal always does; the Windows
+*			 console has to be asked.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void Terminal::EnableAnsi()
+{
+#if defined( _WIN32 )
+	HANDLE handle = GetStdHandle( STD_OUTPUT_HANDLE );
+	DWORD mode = 0;
+
+	if( GetConsoleMode( handle, &mode ) )
+		SetConsoleMode( handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING );
+#endif
+}
+
+/***************************************************************
+*   Purpose: Gets how many system calls have written to the
+*			 screen since the Terminal was made.
+****************************************************************/
+long long Terminal::GetNumWrites() const
+{
+	return m_writes;
+}
+
+/***************************************************************
+*   Purpose: Sends bytes to the screen, normally with a single
+*			 write. It is only split if the system takes part of it
+*			 at a time.
+*
+*     Entry: The bytes and how many there are.
+*
+*      Exit: All of them are written, unless the output failed.
+****************************************************************/
+void Terminal::WriteOut( const char * data, size_t length )
+{
+	while( length > 0 )
+	{
+		m_writes++;
+
+#if defined( _WIN32 )
+		DWORD written = 0;
+
+		if( WriteFile( GetStdHandle( STD_OUTPUT_HANDLE ), data, static_cast<DWORD>( length ),
+					   &written, NULL ) == FALSE || written == 0 )
+			break;
+#else
+		const ssize_t written = write( STDOUT_FILENO, data, length );
+
+		if( written < 0 && errno == EINTR )
+			continue;
+
+		if( written <= 0 )
+			break;
+#endif
+
+		data += written;
+		length -= static_cast<size_t>( written );
+	}
+}
+
+/***************************************************************
+*   Purpose: Flushes whatever is left, puts the input mode back
+*			 and destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Terminal::~Terminal()
+{
+	Flush();
+	SetRawInput( false );
+}
@@ -0,0 +1,109 @@
+/************************************************************************
+* CLASS: Terminal
+*
+* CONSTRUCTORS:
+*	Terminal()
+*		Default constructor for Terminal. Nothing is buffered yet.
+*
+* METHODS:
+*	void Clear()
+*		Clears the screen and moves the cursor to the top left.
+*	void SetColor( Color color )
+*		Prints everything after it in the given colour.
+*	void Print( const char * text )
+*	void Print( char letter )
+*	void Print( int number )
+*		Adds text to the frame being built.
+*	void Write( const char * data, size_t length )
+*		Writes a whole frame that was built somewhere else, such as by
+*		the Renderer, straight to the screen.
+*	void Flush()
+*		Sends everything printed so far to the screen.
+*	void Pause()
+*		Waits for the player to press a key, like system( "pause" ).
+*	void SetRawInput( bool raw )
+*		Turns raw input on, so that ReadKey() gets each key as soon as it
+*		is pressed and nothing is echoed, or back off.
+*	int ReadKey()
+*		Waits for a key and returns it: a character, one of the KEY_
+*		values for the arrow and page keys, or KEY_NONE if the input has
+*		ended.
+*	bool GetSize( int & lines, int & columns ) const
+*		Gets the size of the screen in characters. Returns false if it
+*		is not known.
+*	void EnableAnsi()
+*		Makes the screen understand ANSI cursor and colour sequences.
+*	long long GetNumWrites() const
+*		Gets how many system calls have written to the screen so far.
+*	static const AnsiColor ANSI_COLORS[]
+*		The ANSI sequence of each Color, for frames that are built
+*		somewhere else, such as by the Renderer and the Viewport.
+*	~Terminal()
+*		Flushes whatever is left, turns raw input off and destructs the
+*		object.
+*
+* NOTES:
+*	The same interface is built on the Windows console or on a POSIX
+*	terminal, chosen when compiling. On a POSIX terminal colours and
+*	clears are ANSI sequences added to the frame, so a whole frame is
+*	sent with a single write() when it is flushed, and Pause() reads one
+*	key with the terminal in raw mode. On Windows the console's own
+*	calls are used: the frame is flushed before each colour change or
+*	clear, since those do not travel in the text.
+*
+*	Everything printed through cout is flushed before a frame, so the
+*	two can be mixed. A Terminal cannot be copied.
+*************************************************************************/
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <cstddef>
+#include <string>
+
+class Terminal
+{
+	public:
+		enum Color { DEFAULT, LIGHT_BLUE, RED, GREEN, YELLOW, BLUE };
+		enum Key { KEY_NONE = -1, KEY_UP = 256, KEY_DOWN, KEY_LEFT, KEY_RIGHT,
+				   KEY_PAGE_UP, KEY_PAGE_DOWN, KEY_HOME, KEY_END };
+
+		// An ANSI colour sequence and its length in bytes
+		struct AnsiColor
+		{
+			const char * text;
+			size_t length;
+		};
+
+		// Indexed by Color, the same colours the Windows console shows
+		static const AnsiColor ANSI_COLORS[];
+		static const size_t MAX_ANSI_COLOR_BYTES = 5;
+
+		Terminal();
+		void Clear();
+		void SetColor( Color color );
+		void Print( const char * text );
+		void Print( char letter );
+		void Print( int number );
+		void Write( const char * data, size_t length );
+		void Flush();
+		void Pause();
+		void SetRawInput( bool raw );
+		int  ReadKey();
+		bool GetSize( int & lines, int & columns ) const;
+		void EnableAnsi();
+		long long GetNumWrites() const;
+		~Terminal();
+
+	private:
+		Terminal( const Terminal & copy );
+		Terminal & operator=( const Terminal & rhs );
+
+		void WriteOut( const char * data, size_t length );
+
+		std::string m_frame; // Printed but not yet sent
+		int m_color;         // Colour in use, or -1 if not known
+		long long m_writes;  // System calls made by WriteOut()
+		void * m_saved_input; // Input mode from before SetRawInput(), a termios on POSIX
+};
+
+#endif
@@ -0,0 +1,593 @@
+#include <stdio.h>
+#include <algorithm>
+#include <cstring>
+#include "Viewport.h"
+
+// Most bytes a colour sequence, a number and a cursor move take
+const size_t VIEW_COLOR_BYTES = Terminal::MAX_ANSI_COLOR_BYTES;
+const size_t VIEW_NUMBER_BYTES = 11;
+const size_t VIEW_CURSOR_BYTES = 2 + VIEW_NUMBER_BYTES + 1 + VIEW_NUMBER_BYTES + 1;
+
+// Most bytes repainting one changed Cell takes
+const size_t VIEW_CHANGED_BYTES = VIEW_CURSOR_BYTES + VIEW_COLOR_BYTES + 1;
+
+// Longest status line, whatever the width of the screen
+const int STATUS_LENGTH = 255;
+
+// Most bytes the status line and the final cursor move take
+const size_t VIEW_STATUS_BYTES = VIEW_COLOR_BYTES + VIEW_CURSOR_BYTES + 3 + STATUS_LENGTH +
+								 VIEW_CURSOR_BYTES;
+
+// Value of each digit of a column label, from the ones upwards
+const int PLACES[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+					   1000000000 };
+
+/***************************************************************
+*   Purpose: Counts the decimal digits of a number.
+*
+*     Entry: A number that is not negative.
+*
+*      Exit: Returns the number of digits, at least 1.
+****************************************************************/
+static int CountDigits( int number )
+{
+	int digits = 1;
+
+	while( number >= 10 )
+	{
+		number /= 10;
+		digits++;
+	}
+
+	return digits;
+}
+
+/***************************************************************
+*   Purpose: Default constructor for Viewport. The screen is taken
+*			 to be 24 lines of 80 columns until it is set, and the
+*			 cursor is on the first Cell.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Viewport::Viewport() : m_length( 0 ), m_changed_limit( 0 ), m_lines( 24 ), m_columns( 80 ),
+					   m_rows( 0 ), m_cols( 0 ), m_row_digits( 1 ), m_col_digits( 1 ),
+					   m_view_rows( 0 ), m_view_cols( 0 ), m_top( 0 ), m_left( 0 ),
+					   m_drawn_top( -1 ), m_drawn_left( -1 ), m_cursor_row( 0 ),
+					   m_cursor_col( 0 ), m_color( -1 ), m_writes( 0 ), m_full_redraw( true )
+{
+	m_terminal.EnableAnsi();
+}
+
+/***************************************************************
+*   Purpose: Sets the size of the screen the Board is drawn on.
+*			 The window is laid out again on the next frame if the
+*			 size changed.
+*
+*     Entry: The number of lines and columns of the screen.
+*
+*      Exit: None
+****************************************************************/
+void Viewport::SetScreenSize( int lines, int columns )
+{
+	if( lines != m_lines || columns != m_columns )
+	{
+		m_lines = lines;
+		m_columns = columns;
+		m_rows = 0;
+		m_cols = 0;
+	}
+}
+
+/***************************************************************
+*   Purpose: Moves the cursor to a Cell. It is kept on the Board
+*			 and the window scrolls to it on the next frame.
+*
+*     Entry: The row and column of the Cell.
+*
+*      Exit: None
+****************************************************************/
+void Viewport::SetCursor( int row, int col )
+{
+	m_cursor_row = row;
+	m_cursor_col = col;
+}
+
+/***************************************************************
+*   Purpose: Moves the cursor by the given number of rows and
+*			 columns. It stops at the edges of the Board.
+*
+*     Entry: The rows to move down and the columns to move right,
+*			 either of which can be negative.
+*
+*      Exit: None
+****************************************************************/
+void Viewport::MoveCursor( int rows, int cols )
+{
+	m_cursor_row += rows;
+	m_cursor_col += cols;
+
+	if( m_rows > 0 && m_cols > 0 )
+	{
+		m_cursor_row = std::max( 0, std::min( m_cursor_row, m_rows - 1 ) );
+		m_cursor_col = std::max( 0, std::min( m_cursor_col, m_cols - 1 ) );
+	}
+}
+
+/***************************************************************
+*   Purpose: Gets the row of the Cell the cursor is on.
+****************************************************************/
+int Viewport::GetCursorRow() const
+{
+	return m_cursor_row;
+}
+
+/***************************************************************
+*   Purpose: Gets the column of the Cell the cursor is on.
+****************************************************************/
+int Viewport::GetCursorCol() const
+{
+	return m_cursor_col;
+}
+
+/***************************************************************
+*   Purpose: Gets how many rows of Cells the window showed in the
+*			 last frame.
+****************************************************************/
+int Viewport::GetViewRows() const
+{
+	return m_view_rows;
+}
+
+/***************************************************************
+*   Purpose: Gets how many columns of Cells the window showed in
+*			 the last frame.
+****************************************************************/
+int Viewport::GetViewCols() const
+{
+	return m_view_cols;
+}
+
+/***************************************************************
+*   Purpose: Sets a message to show at the end of the status line
+*			 from the next frame on.
+*
+*     Entry: The message, or nullptr for none.
+*
+*      Exit: None
+****************************************************************/
+void Viewport::SetMessage( const char * message )
+{
+	m_message = message == nullptr ? "" : message;
+}
+
+/***************************************************************
+*   Purpose: Builds the next frame for the Board and writes it to
+*			 the console with a single write.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: The screen shows the window. Returns the number of
+*			 Cells still covered (flagged Cells count as covered).
+****************************************************************/
+int Viewport::Draw( const Board & board )
+{
+	BuildFrame( board );
+
+	const long long before = m_terminal.GetNumWrites();
+
+	m_terminal.Write( m_frame.data(), m_length );
+	m_writes = m_terminal.GetNumWrites() - before;
+
+	return board.GetNumCovered();
+}
+
+/***************************************************************
+*   Purpose: Builds the next frame for the Board without writing
+*			 it anywhere. The frame is a full redraw if nothing has
+*			 been drawn yet, Invalidate() was called, the window
+*			 scrolled, the size of the screen or Board changed or
+*			 the changes would take more than a full redraw, and
+*			 only the changed Cells otherwise. The status line is
+*			 always drawn.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: Returns the size of the frame in bytes. GetFrame()
+*			 has it until the next call.
+****************************************************************/
+size_t Viewport::BuildFrame( const Board & board )
+{
+	m_length = 0;
+
+	if( board.GetRows() != m_rows || board.GetCols() != m_cols )
+		Layout( board.GetRows(), board.GetCols() );
+
+	FollowCursor();
+
+	if( m_top != m_drawn_top || m_left != m_drawn_left )
+		m_full_redraw = true;
+
+	if( m_full_redraw == false && BuildChangedCells( board ) == false )
+	{
+		m_length = 0;
+		m_full_redraw = true;
+	}
+
+	if( m_full_redraw )
+		BuildFullFrame( board );
+
+	AppendStatus( board );
+	m_drawn_top = m_top;
+	m_drawn_left = m_left;
+	m_full_redraw = false;
+
+	return m_length;
+}
+
+/***************************************************************
+*   Purpose: Gets the frame last built.
+*
+*     Entry: None
+*
+*      Exit: Returns its first byte. GetFrameBytes() gives its
+*			 size.
+****************************************************************/
+const char * Viewport::GetFrame() const
+{
+	return m_frame.data();
+}
+
+/***************************************************************
+*   Purpose: Forgets what is on the screen so that the next frame
+*			 is a full redraw.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+void Viewport::Invalidate()
+{
+	m_full_redraw = true;
+}
+
+/***************************************************************
+*   Purpose: Returns the size in bytes of the last frame.
+****************************************************************/
+size_t Viewport::GetFrameBytes() const
+{
+	return m_length;
+}
+
+/***************************************************************
+*   Purpose: Returns how many system calls the last Draw() took
+*			 to write its frame.
+****************************************************************/
+long long Viewport::GetFrameWrites() const
+{
+	return m_writes;
+}
+
+/***************************************************************
+*   Purpose: Works out the size of the labels and the window for
+*			 the screen and a size of Board, and sizes the buffers
+*			 to match. The frame buffer holds the largest full
+*			 frame, which is also the most a frame of changes is let
+*			 grow to.
+*
+*     Entry: The size of the Board.
+*
+*      Exit: The next frame is a full redraw.
+****************************************************************/
+void Viewport::Layout( int rows, int cols )
+{
+	m_rows = rows;
+	m_cols = cols;
+	m_row_digits = CountDigits( rows );
+	m_col_digits = CountDigits( cols );
+
+	const int gutter = m_row_digits + 2;
+
+	// The last line is the status line, and the last column is left
+	// empty so that no line wraps
+	m_view_rows = std::min( rows, std::max( 1, m_lines - m_col_digits - 1 ) );
+	m_view_cols = std::min( cols, std::max( 1, ( m_columns - 1 - gutter ) / 2 ) );
+	m_previous.assign( static_cast<size_t>( m_view_rows ) * m_view_cols, '\0' );
+	m_row.resize( m_view_cols );
+
+	// The clear and the lines of column labels, then each row's
+	// colour, label and new line and each Cell's colour, symbol and
+	// space
+	size_t size = VIEW_COLOR_BYTES + 7 + VIEW_COLOR_BYTES;
+
+	size += static_cast<size_t>( m_col_digits ) * ( gutter + ( 2 * m_view_cols ) + 1 );
+	size += static_cast<size_t>( m_view_rows ) * ( VIEW_COLOR_BYTES + gutter + 1 );
+	size += static_cast<size_t>( m_view_rows ) * m_view_cols * ( VIEW_COLOR_BYTES + 2 );
+
+	m_frame.resize( size + VIEW_STATUS_BYTES );
+	m_changed_limit = size > VIEW_CHANGED_BYTES ? size - VIEW_CHANGED_BYTES : 0;
+	m_full_redraw = true;
+}
+
+/***************************************************************
+*   Purpose: Keeps the cursor on the Board and the window on the
+*			 cursor. When the cursor leaves the window the window
+*			 is moved to put it in the middle, so that moving along
+*			 does not scroll on every step.
+*
+*     Entry: The window is laid out.
+*
+*      Exit: The cursor is in the window.
+****************************************************************/
+void Viewport::FollowCursor()
+{
+	m_cursor_row = std::max( 0, std::min( m_cursor_row, m_rows - 1 ) );
+	m_cursor_col = std::max( 0, std::min( m_cursor_col, m_cols - 1 ) );
+
+	if( m_cursor_row < m_top || m_cursor_row >= m_top + m_view_rows )
+		m_top = m_cursor_row - ( m_view_rows / 2 );
+
+	if( m_cursor_col < m_left || m_cursor_col >= m_left + m_view_cols )
+		m_left = m_cursor_col - ( m_view_cols / 2 );
+
+	m_top = std::max( 0, std::min( m_top, m_rows - m_view_rows ) );
+	m_left = std::max( 0, std::min( m_left, m_cols - m_view_cols ) );
+}
+
+/***************************************************************
+*   Purpose: Clears the screen and draws the labels and every
+*			 Cell in the window.
+*
+*     Entry: The Board to draw.
+*
+*      Exit: The frame holds the whole window.
+****************************************************************/
+void Viewport::BuildFullFrame( const Board & board )
+{
+	const CellGrid grid = board.GetGrid();
+	const int gutter = m_row_digits + 2;
+
+	m_color = -1;
+	AppendColor( Terminal::DEFAULT );
+	Append( "\x1b[H\x1b[2J", 7 );
+	AppendColor( Terminal::LIGHT_BLUE );
+
+	// Each column's number reads downwards, most significant digit
+	// first, without leading zeros
+	for( int line = 0; line < m_col_digits; line++ )
+	{
+		const int place = PLACES[m_col_digits - 1 - line];
+
+		memset( &m_frame[m_length], ' ', gutter );
+		m_length += gutter;
+
+		for( int c = 0; c < m_view_cols; c++ )
+		{
+			const int number = m_left + c + 1;
+
+			if( number >= place || place == 1 )
+				m_frame[m_length++] = static_cast<char>( '0' + ( ( number / place ) % 10 ) );
+			else
+				m_frame[m_length++] = ' ';
+
+			m_frame[m_length++] = ' ';
+		}
+
+		m_frame[m_length++] = '\n';
+	}
+
+	for( int r = 0; r < m_view_rows; r++ )
+	{
+		const unsigned char * states = GetStates( board, grid, m_top + r );
+		char * previous = &m_previous[static_cast<size_t>( r ) * m_view_cols];
+
+		AppendColor( Terminal::LIGHT_BLUE );
+		AppendNumber( m_top + r + 1, m_row_digits );
+		m_frame[m_length++] = ' ';
+		m_frame[m_length++] = ' ';
+
+		for( int c = 0; c < m_view_cols; c++ )
+		{
+			const Glyph & glyph = m_glyphs[states[c]];
+
+			AppendColor( glyph.color );
+			m_frame[m_length++] = glyph.symbol;
+			m_frame[m_length++] = ' ';
+			previous[c] = glyph.symbol;
+		}
+
+		if( r + 1 < m_view_rows )
+			m_frame[m_length++] = '\n';
+	}
+}
+
+/***************************************************************
+*   Purpose: Repaints only the Cells in the window whose symbol is
+*			 different from the one that was drawn last time.
+*
+*     Entry: The Board to draw. The window has not scrolled.
+*
+*      Exit: The frame holds a cursor move and symbol for every
+*			 changed Cell. Returns false, part way through, if the
+*			 changes would take more than a full frame.
+****************************************************************/
+bool Viewport::BuildChangedCells( const Board & board )
+{
+	const CellGrid grid = board.GetGrid();
+	const int first_line = m_col_digits + 1;
+	const int first_column = m_row_digits + 3;
+
+	for( int r = 0; r < m_view_rows; r++ )
+	{
+		const unsigned char * states = GetStates( board, grid, m_top + r );
+		char * previous = &m_previous[static_cast<size_t>( r ) * m_view_cols];
+
+		for( int c = 0; c < m_view_cols; c++ )
+		{
+			const Glyph & glyph = m_glyphs[states[c]];
+
+			if( glyph.symbol != previous[c] )
+			{
+				if( m_length > m_changed_limit )
+					return false;
+
+				AppendCursor( first_line + r, first_column + ( 2 * c ) );
+				AppendColor( glyph.color );
+				m_frame[m_length++] = glyph.symbol;
+				previous[c] = glyph.symbol;
+			}
+		}
+	}
+
+	return true;
+}
+
+/***************************************************************
+*   Purpose: Gets the state bytes of the Cells of one row that are
+*			 in the window. They are read straight from the Board
+*			 unless it is chunked, when they are copied into a
+*			 buffer the width of the window.
+*
+*     Entry: The Board, its grid (empty if it is chunked) and the
+*			 row.
+*
+*      Exit: Returns the state of each Cell of the row from the
+*			 window's first column on.
+****************************************************************/
+const unsigned char * Viewport::GetStates( const Board & board, const CellGrid & grid, int row )
+{
+	if( grid.GetRows() > 0 )
+		return reinterpret_cast<const unsigned char *>( &grid.GetCell( row, m_left ) );
+
+	for( int c = 0; c < m_view_cols; c++ )
+		m_row[c] = reinterpret_cast<const unsigned char &>( board.GetCell( row, m_left + c ) );
+
+	return m_row.data();
+}
+
+/***************************************************************
+*   Purpose: Draws the status line below the window, with the
+*			 cursor's position, the counts from the Board and the
+*			 message, then leaves the terminal's cursor on the Cell
+*			 the cursor is on.
+*
+*     Entry: The Board being drawn.
+*
+*      Exit: The frame ends with the status line.
+****************************************************************/
+void Viewport::AppendStatus( const Board & board )
+{
+	char status[STATUS_LENGTH + 1];
+	int  length = 0;
+
+	// A chunked Board only counts its stored tiles, and its bombs are
+	// per tile, so it shows how much has been explored instead
+	if( board.IsChunked() )
+	{
+		length = snprintf( status, sizeof( status ), "Row %d/%d  Column %d/%d  Revealed %d  Flags %d  Tiles %d%s%s",
+						   m_cursor_row + 1, m_rows, m_cursor_col + 1, m_cols,
+						   board.GetNumRevealed(), board.GetNumFlags(), board.GetNumTiles(),
+						   m_message.empty() ? "" : "  ", m_message.c_str() );
+	}
+	else
+	{
+		length = snprintf( status, sizeof( status ), "Row %d/%d  Column %d/%d  Covered %d  Flags %d/%d%s%s",
+						   m_cursor_row + 1, m_rows, m_cursor_col + 1, m_cols,
+						   board.GetNumCovered(), board.GetNumFlags(), board.GetBombs(),
+						   m_message.empty() ? "" : "  ", m_message.c_str() );
+	}
+
+	length = std::max( 0, std::min( std::min( length, STATUS_LENGTH ), m_columns - 1 ) );
+
+	AppendColor( Terminal::DEFAULT );
+	AppendCursor( m_col_digits + m_view_rows + 1, 1 );
+	Append( "\x1b[K", 3 );
+	Append( status, length );
+	AppendCursor( m_col_digits + 1 + ( m_cursor_row - m_top ),
+				  m_row_digits + 3 + ( 2 * ( m_cursor_col - m_left ) ) );
+}
+
+/***************************************************************
+*   Purpose: Adds an ANSI colour change to the frame, unless the
+*			 colour is already the one in use.
+*
+*     Entry: The Terminal::Color.
+*
+*      Exit: The frame is switched to that colour.
+****************************************************************/
+void Viewport::AppendColor( int color )
+{
+	if( color != m_color )
+	{
+		Append( Terminal::ANSI_COLORS[color].text, Terminal::ANSI_COLORS[color].length );
+		m_color = color;
+	}
+}
+
+/***************************************************************
+*   Purpose: Adds an ANSI cursor move to the frame.
+*
+*     Entry: The line and column to move to, both starting at 1.
+*
+*      Exit: None
+****************************************************************/
+void Viewport::AppendCursor( int line, int column )
+{
+	m_frame[m_length++] = '\x1b';
+	m_frame[m_length++] = '[';
+	AppendNumber( line, 0 );
+	m_frame[m_length++] = ';';
+	AppendNumber( column, 0 );
+	m_frame[m_length++] = 'H';
+}
+
+/***************************************************************
+*   Purpose: Adds a number to the frame in decimal, with spaces in
+*			 front to fill the width.
+*
+*     Entry: The number, which is not negative, and the width (0
+*			 for no spaces).
+*
+*      Exit: None
+****************************************************************/
+void Viewport::AppendNumber( int number, int width )
+{
+	char digits[12];
+	int  length = 0;
+
+	do
+	{
+		digits[length++] = static_cast<char>( '0' + ( number % 10 ) );
+		number /= 10;
+	} while( number != 0 );
+
+	for( int i = length; i < width; i++ )
+		m_frame[m_length++] = ' ';
+
+	while( length > 0 )
+		m_frame[m_length++] = digits[--length];
+}
+
+/***************************************************************
+*   Purpose: Adds bytes to the frame.
+*
+*     Entry: The bytes and how many there are.
+*
+*      Exit: None
+****************************************************************/
+void Viewport::Append( const char * text, size_t length )
+{
+	memcpy( &m_frame[m_length], text, length );
+	m_length += length;
+}
+
+/***************************************************************
+*   Purpose: Destructs the object.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+Viewport::~Viewport()
+{ }
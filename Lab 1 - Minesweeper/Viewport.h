@@ -0,0 +1,135 @@
+/************************************************************************
+* CLASS: Viewport
+*
+* CONSTRUCTORS:
+*	Viewport()
+*		Default constructor for Viewport. The screen is taken to be 24
+*		lines of 80 columns and the cursor is on the first Cell.
+*
+* METHODS:
+*	void SetScreenSize( int lines, int columns )
+*		Sets the size of the screen the Board is drawn on.
+*	void SetCursor( int row, int col )
+*		Moves the cursor to a Cell. The window scrolls to keep it shown.
+*	void MoveCursor( int rows, int cols )
+*		Moves the cursor by the given number of rows and columns.
+*	int GetCursorRow() const
+*	int GetCursorCol() const
+*		Get the Cell the cursor is on.
+*	int GetViewRows() const
+*	int GetViewCols() const
+*		Get how many rows and columns of Cells the window shows, as of the
+*		last frame.
+*	void SetMessage( const char * message )
+*		Sets a message to show at the end of the status line.
+*	int Draw( const Board & board )
+*		Builds the next frame for the Board and writes it to the console
+*		in one go. Returns the number of Cells still covered.
+*	size_t BuildFrame( const Board & board )
+*		Builds the next frame for the Board without writing it anywhere.
+*		Returns its size in bytes.
+*	const char * GetFrame() const
+*		Gets the frame last built.
+*	void Invalidate()
+*		Forgets what is on the screen so that the next frame is a full
+*		redraw.
+*	size_t GetFrameBytes() const
+*		Returns the size in bytes of the last frame.
+*	long long GetFrameWrites() const
+*		Returns how many system calls the last Draw() took to write its
+*		frame.
+*	~Viewport()
+*		Destructs the object.
+*
+* NOTES:
+*	A Viewport draws only the window of the Board that fits on the
+*	screen, so the cost of a frame depends on the size of the screen and
+*	not the size of the Board. The window scrolls when the cursor leaves
+*	it, putting the cursor back in the middle, and the terminal's own
+*	cursor is left on the Cell the cursor is on.
+*
+*	Rows and columns are numbered from 1 so that the labels work on a
+*	Board of any size. The row numbers are down the left, and the column
+*	numbers are written downwards above each column, one digit per line,
+*	since each Cell is only two characters wide. The last line is the
+*	status line.
+*
+*	Like the Renderer, the Viewport remembers the symbol it last drew in
+*	each place in the window and after a full frame only repaints the
+*	Cells that changed. Scrolling, or a change in the size of the screen
+*	or the Board, draws a full frame. The frame buffer is sized once for
+*	each size of screen and Board.
+*************************************************************************/
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "GlyphTable.h"
+#include "Terminal.h"
+
+class Viewport
+{
+	public:
+		Viewport();
+		void SetScreenSize( int lines, int columns );
+		void SetCursor( int row, int col );
+		void MoveCursor( int rows, int cols );
+		int  GetCursorRow() const;
+		int  GetCursorCol() const;
+		int  GetViewRows() const;
+		int  GetViewCols() const;
+		void SetMessage( const char * message );
+		int  Draw( const Board & board );
+		size_t BuildFrame( const Board & board );
+		const char * GetFrame() const;
+		void Invalidate();
+		size_t GetFrameBytes() const;
+		long long GetFrameWrites() const;
+		~Viewport();
+
+	private:
+		Viewport( const Viewport & copy );
+		Viewport & operator=( const Viewport & rhs );
+
+		void Layout( int rows, int cols );
+		void FollowCursor();
+		void BuildFullFrame( const Board & board );
+		bool BuildChangedCells( const Board & board );
+		const unsigned char * GetStates( const Board & board, const CellGrid & grid, int row );
+		void AppendStatus( const Board & board );
+		void AppendColor( int color );
+		void AppendCursor( int line, int column );
+		void AppendNumber( int number, int width );
+		void Append( const char * text, size_t length );
+
+		Terminal m_terminal;
+		GlyphTable m_glyphs;
+		std::vector<char> m_previous;    // Symbol last drawn in each place in the window
+		std::vector<unsigned char> m_row; // States of a chunked Board's row in the window
+		std::vector<char> m_frame;
+		std::string m_message;
+		size_t m_length;                 // Bytes of m_frame in use
+		size_t m_changed_limit;          // Most a frame of changes may take
+		int  m_lines;                    // Size of the screen
+		int  m_columns;
+		int  m_rows;                     // Size of the Board laid out for
+		int  m_cols;
+		int  m_row_digits;               // Width of the row labels
+		int  m_col_digits;               // Lines of column labels
+		int  m_view_rows;                // Size of the window in Cells
+		int  m_view_cols;
+		int  m_top;                      // First row and column in the window
+		int  m_left;
+		int  m_drawn_top;                // Window on the screen, or -1 if none
+		int  m_drawn_left;
+		int  m_cursor_row;
+		int  m_cursor_col;
+		int  m_color;
+		long long m_writes;
+		bool m_full_redraw;
+};
+
+#endif
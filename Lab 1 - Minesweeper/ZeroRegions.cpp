@@ -0,0 +1,216 @@
+#include <cstddef>
+#include "ZeroRegions.h"
+
+/***************************************************************
+*   Purpose: Default constructor for ZeroRegions. No regions are
+*			 labelled.
+*
+*     Entry: None
+*
+*      Exit: None
+****************************************************************/
+ZeroRegions::ZeroRegions() : m_cols( 0 )
+{ }
+
+/***************************************************************
+*   Purpose: Labels the blank regions of a board and stores the
+*			 Cells of each one with its numbered border. See the
+*			 NOTES in ZeroRegions.h.
+*
+*     Entry: The Cells of the board in row order, with the bombs
+*			 and numbers set, and its size.
+*
+*      Exit: Every blank Cell has its region and every region has
+*			 its list of Cells, in row order.
+****************************************************************/
+void ZeroRegions::Label( const Cell * cells, int rows, int cols )
+{
+	const unsigned char * states = reinterpret_cast<const unsigned char *>( cells );
+	const int width = cols + 2;
+	const int above[4] = { -1, -width - 1, -width, -width + 1 };
+	const int around[8] = { -width - 1, -width, -width + 1, -1, 1, width - 1, width, width + 1 };
+	std::vector<int> parents; // Label each label was merged into
+	std::vector<int> ids;
+	int regions = 0;
+
+	m_cols = cols;
+	m_labels.assign( static_cast<size_t>( rows + 2 ) * width, -1 );
+
+	// The neighbours already passed are the one to the left and
+	// the three in the row above. The border of -1 labels means
+	// none of them needs a bounds check.
+	for( int r = 0; r < rows; ++r )
+	{
+		const unsigned char * row = states + ( static_cast<size_t>( r ) * cols );
+		int * labels = &m_labels[( ( r + 1 ) * width ) + 1];
+
+		for( int c = 0; c < cols; ++c )
+		{
+			int label = -1;
+
+			if( ( row[c] & ( Cell::BOMB_BIT | Cell::NUM_BOMBS_MASK ) ) != 0 )
+				continue;
+
+			for( int n = 0; n < 4; ++n )
+			{
+				if( labels[c + above[n]] < 0 )
+					continue;
+
+				const int root = FindRoot( parents, labels[c + above[n]] );
+
+				if( label < 0 )
+					label = root;
+				else if( root < label )
+				{
+					parents[label] = root;
+					label = root;
+				}
+				else if( root > label )
+					parents[root] = label;
+			}
+
+			if( label < 0 )
+			{
+				label = static_cast<int>( parents.size() );
+				parents.push_back( label );
+			}
+
+			labels[c] = label;
+		}
+	}
+
+	// Number the merged labels from 0 in the order they are met
+	ids.assign( parents.size(), -1 );
+
+	for( int & label : m_labels )
+	{
+		if( label < 0 )
+			continue;
+
+		const int root = FindRoot( parents, label );
+
+		if( ids[root] < 0 )
+			ids[root] = regions++;
+
+		label = ids[root];
+	}
+
+	// Count the Cells of each region, then store them. A numbered
+	// Cell is stored once for each different region around it; a
+	// bomb never has a blank Cell around it.
+	m_starts.assign( regions + 1, 0 );
+
+	for( int pass = 0; pass < 2; ++pass )
+	{
+		std::vector<int> next;
+
+		if( pass == 1 )
+		{
+			for( int region = 0; region < regions; ++region )
+				m_starts[region + 1] += m_starts[region];
+
+			m_cells.resize( m_starts[regions] );
+			next.assign( m_starts.begin(), m_starts.end() - 1 );
+		}
+
+		for( int r = 0; r < rows; ++r )
+		{
+			const unsigned char * row = states + ( static_cast<size_t>( r ) * cols );
+			const int * labels = &m_labels[( ( r + 1 ) * width ) + 1];
+
+			for( int c = 0; c < cols; ++c )
+			{
+				const int index = ( r * cols ) + c;
+				int found[8];
+				int num_found = 0;
+
+				// The labels are all negative only if their and is, which
+				// skips most numbered Cells without a branch per neighbour
+				const int * near = labels + c;
+				const int none = near[around[0]] & near[around[1]] & near[around[2]] &
+								 near[around[3]] & near[around[4]] & near[around[5]] &
+								 near[around[6]] & near[around[7]];
+
+				if( labels[c] >= 0 )
+					found[num_found++] = labels[c];
+				else if( none >= 0 && ( row[c] & Cell::BOMB_BIT ) == 0 )
+				{
+					for( int n = 0; n < 8; ++n )
+					{
+						const int region = labels[c + around[n]];
+						bool seen = region < 0;
+
+						for( int i = 0; i < num_found && seen == false; ++i )
+							seen = found[i] == region;
+
+						if( seen == false )
+							found[num_found++] = region;
+					}
+				}
+
+				for( int i = 0; i < num_found; ++i )
+				{
+					if( pass == 0 )
+						m_starts[found[i] + 1]++;
+					else
+						m_cells[next[found[i]]++] = index;
+				}
+			}
+		}
+	}
+}
+
+/***************************************************************
+*   Purpose: Gets the region of a Cell.
+*
+*     Entry: The index of the Cell, ( row * columns ) + column.
+*
+*      Exit: Returns the region, or -1 if the Cell is not blank.
+****************************************************************/
+int ZeroRegions::GetRegion( int index ) const
+{
+	const int row = index / m_cols;
+
+	return m_labels[( ( row + 1 ) * ( m_cols + 2 ) ) + ( index - ( row * m_cols ) ) + 1];
+}
+
+/***************************************************************
+*   Purpose: Gets the number of blank regions.
+****************************************************************/
+int ZeroRegions::GetNumRegions() const
+{
+	return m_starts.empty() ? 0 : static_cast<int>( m_starts.size() ) - 1;
+}
+
+/***************************************************************
+*   Purpose: Gets every Cell a cascade into a region uncovers.
+*
+*     Entry: The region and where to store how many Cells it has.
+*
+*      Exit: Returns the first of the indexes of its Cells.
+****************************************************************/
+const int * ZeroRegions::GetCells( int region, int & count ) const
+{
+	count = m_starts[region + 1] - m_starts[region];
+
+	return m_cells.data() + m_starts[region];
+}
+
+/***************************************************************
+*   Purpose: Finds the label a label was merged into, halving the
+*			 path on the way so later finds are quicker.
+*
+*     Entry: The labels each one was merged into and a label.
+*
+*      Exit: Returns the label that was not merged into another.
+****************************************************************/
+int ZeroRegions::FindRoot( std::vector<int> & parents, int label )
+{
+	while( parents[label] != label )
+	{
+		parents[label] = parents[parents[label]];
+		label = parents[label];
+	}
+
+	return label;
+}
@@ -0,0 +1,59 @@
+/************************************************************************
+* CLASS: ZeroRegions
+*
+* CONSTRUCTORS:
+*	ZeroRegions()
+*		Default constructor for ZeroRegions. No regions are labelled.
+*
+* METHODS:
+*	void Label( const Cell * cells, int rows, int cols )
+*		Labels the blank regions of a board whose bombs and numbers are
+*		set, kept in row order.
+*	int GetRegion( int index ) const
+*		Gets the region of the Cell at the given index, ( row * columns )
+*		+ column, or -1 if it is not blank.
+*	int GetNumRegions() const
+*		Gets the number of blank regions.
+*	const int * GetCells( int region, int & count ) const
+*		Gets the indexes of every Cell a cascade into the region uncovers:
+*		its blank Cells and the numbered Cells around them.
+*
+* NOTES:
+*	A blank region is a set of blank Cells joined through their eight
+*	neighbours. Once the bombs are placed the regions never change, so
+*	they are found once with two passes over the board: the first gives
+*	each blank Cell the label of a blank neighbour already passed, or a
+*	new label, and merges labels that meet with union-find; the second
+*	numbers the merged labels from 0. The Cells of each region, with its
+*	numbered border, are then stored one region after another. The
+*	labels have a border of -1 around the board so that no neighbour
+*	needs a bounds check.
+*
+*	The labels take an int per Cell and the lists about another int per
+*	Cell that a cascade could reach.
+*************************************************************************/
+#ifndef ZEROREGIONS_H
+#define ZEROREGIONS_H
+
+#include <vector>
+#include "Cell.h"
+
+class ZeroRegions
+{
+	public:
+		ZeroRegions();
+		void Label( const Cell * cells, int rows, int cols );
+		int  GetRegion( int index ) const;
+		int  GetNumRegions() const;
+		const int * GetCells( int region, int & count ) const;
+
+	private:
+		static int FindRoot( std::vector<int> & parents, int label );
+
+		int m_cols;
+		std::vector<int> m_labels; // Region of each Cell, or -1, with a border of -1
+		std::vector<int> m_starts; // Where each region's Cells start in m_cells
+		std::vector<int> m_cells;  // The Cells of every region, region by region
+};
+
+#endif